@@ -0,0 +1,230 @@
+/*****************************************************************************
+ * @file    		KDI_Format.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Format module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for convert numbers to strings for displays without sprintf.
+ * Digits are found by subtraction of powers of ten, no more than 9 subtractions for each digit,
+ * so the division is not used. Float is converted to fixed-point and printed as fixed-point.
+ *
+ */
+
+#include "KDI_Format.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 		Powers of ten from the biggest for 32 bit number
+ */
+static const uint32_t KDI_Format_pow10[10] = {
+
+	1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+	10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+/**
+ * @brief 		Number of characters of overflow when width is 0
+ */
+#define KDI_FORMAT_OVERFLOW_WIDTH		4
+
+/**
+  * @brief 		Convert number to digits without leading zeros
+  *
+  * @param  	Pointer on buffer for digits, not less than 10 characters
+  * @param  	Number
+  *	@return		Number of digits, at least 1
+  */
+
+static uint8_t KDI_Format_Digits(char* digits, uint32_t value){
+
+	uint8_t count = 0;
+
+	for(uint8_t i = 0; i < 10; i++){
+
+		uint32_t pow10 = KDI_Format_pow10[i];
+
+		char digit = '0';
+
+		/* Subtraction instead of division*/
+		while(value >= pow10){
+
+			value -= pow10;
+			digit++;
+		}
+
+		/* Skip leading zeros, the last digit is always saved*/
+		if(count || digit != '0' || i == 9) digits[count++] = digit;
+	}
+
+	return count;
+}
+
+/**
+  * @brief 		Fill buffer with overflow characters
+  *
+  * @param  	Pointer on buffer
+  * @param  	Width of the string
+  *	@return		Length of the string
+  */
+
+static uint8_t KDI_Format_Overflow(char* buffer, uint8_t width){
+
+	if(!width) width = KDI_FORMAT_OVERFLOW_WIDTH;
+
+	for(uint8_t i = 0; i < width; i++) buffer[i] = KDI_FORMAT_OVERFLOW;
+
+	buffer[width] = 0;
+
+	return width;
+}
+
+/**
+  * @brief 		Put sign, digits and point into buffer with right alignment
+  *
+  * @param  	Pointer on buffer
+  * @param  	1 - number is negative
+  * @param  	Absolute value of number
+  * @param  	Number of decimal places, not more than 9
+  * @param  	Width of the string, 0 - no alignment
+  *	@return		Length of the string
+  */
+
+static uint8_t KDI_Format_Put(char* buffer, uint8_t negative, uint32_t value, uint8_t decimals, uint8_t width){
+
+	char digits[10];
+
+	if(decimals > 9) decimals = 9;
+
+	uint8_t count = KDI_Format_Digits(digits, value);
+
+	/* Leading zeros of fixed-point number, for example 5 -> "0.05"*/
+	uint8_t zeros = (count <= decimals) ? (uint8_t)(decimals + 1 - count) : 0;
+
+	/* Length of the string and number of places on the display*/
+	uint8_t length = (uint8_t)(negative + zeros + count + (decimals ? 1 : 0));
+
+	uint8_t places = length;
+
+#if KDI_FORMAT_POINT_IN_DIGIT
+	if(decimals) places--;
+#endif
+
+	/* Number does not fit*/
+	if(width && places > width) return KDI_Format_Overflow(buffer, width);
+
+	uint8_t position = 0;
+
+	/* Right alignment*/
+	if(width){
+
+		while(places < width){
+
+			buffer[position++] = ' ';
+			places++;
+		}
+	}
+
+	if(negative) buffer[position++] = '-';
+
+	/* Integer part, then point, then decimal part*/
+	uint8_t integer = (uint8_t)(zeros + count - decimals);
+
+	for(uint8_t i = 0; i < zeros + count; i++){
+
+		if(i == integer) buffer[position++] = KDI_FORMAT_POINT;
+
+		buffer[position++] = (i < zeros) ? '0' : digits[i - zeros];
+	}
+
+	buffer[position] = 0;
+
+	return position;
+}
+
+/**
+  * @brief 		Convert signed integer to string
+  *
+  * @param  	Pointer on buffer
+  * @param  	Number
+  * @param  	Width of the string, 0 - no alignment
+  *	@return		Length of the string
+  */
+
+uint8_t KDI_Format_Int(char* buffer, int32_t value, uint8_t width){
+
+	return KDI_Format_Fixed(buffer, value, 0, width);
+}
+
+/**
+  * @brief 		Convert unsigned integer to string
+  *
+  * @param  	Pointer on buffer
+  * @param  	Number
+  * @param  	Width of the string, 0 - no alignment
+  *	@return		Length of the string
+  */
+
+uint8_t KDI_Format_Uint(char* buffer, uint32_t value, uint8_t width){
+
+	return KDI_Format_Put(buffer, 0, value, 0, width);
+}
+
+/**
+  * @brief 		Convert fixed-point number to string
+  *
+  * @param  	Pointer on buffer
+  * @param  	Number multiplied by 10^decimals, for example 1234 with 2 decimals is "12.34"
+  * @param  	Number of decimal places, not more than 9
+  * @param  	Width of the string, 0 - no alignment
+  *	@return		Length of the string
+  */
+
+uint8_t KDI_Format_Fixed(char* buffer, int32_t value, uint8_t decimals, uint8_t width){
+
+	/* Absolute value, works also for INT32_MIN*/
+	uint32_t magnitude = (value < 0) ? 0UL - (uint32_t)value : (uint32_t)value;
+
+	return KDI_Format_Put(buffer, value < 0, magnitude, decimals, width);
+}
+
+/**
+  * @brief 		Convert float to string with fixed number of decimal places
+  *
+  * @param  	Pointer on buffer
+  * @param  	Number
+  * @param  	Number of decimal places, not more than 9
+  * @param  	Width of the string, 0 - no alignment
+  *	@return		Length of the string
+  *
+  * @note		NaN, infinity and numbers bigger than 32 bit after scaling are shown as overflow.
+  */
+
+uint8_t KDI_Format_Float(char* buffer, float value, uint8_t decimals, uint8_t width){
+
+	if(decimals > 9) decimals = 9;
+
+	uint8_t negative = (value < 0.0f);
+
+	if(negative) value = -value;
+
+	/* Scale to fixed-point and round*/
+	value = value * (float)KDI_Format_pow10[9 - decimals] + 0.5f;
+
+	/* NaN or number does not fit in 32 bit*/
+	if(!(value < 4294967296.0f)) return KDI_Format_Overflow(buffer, width);
+
+	uint32_t magnitude = (uint32_t)value;
+
+	/* "-0.00" is shown as "0.00"*/
+	if(!magnitude) negative = 0;
+
+	return KDI_Format_Put(buffer, negative, magnitude, decimals, width);
+}
+
+#ifdef __cplusplus
+}
+#endif
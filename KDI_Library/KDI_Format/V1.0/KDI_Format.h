@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * @file    		KDI_Format.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Format module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for convert numbers to strings for displays without sprintf.
+ * sprintf takes a lot of flash and time, especially with float. These functions use
+ * only addition and subtraction, so they are fast also on Cortex-M0 without division.
+ * The string is aligned to the right on the given number of characters (width), for N-digit displays.
+ * If the number does not fit in width, the string is filled with '-', for example "----".
+ * Width 0 means no alignment, overflow is then shown as "----" (only float can overflow).
+ * The buffer must have at least KDI_FORMAT_BUFFER_SIZE characters, or width + 2 for bigger width.
+ *
+ * 									##### How to use this driver #####
+ * 1) Declare a buffer char buffer[KDI_FORMAT_BUFFER_SIZE].
+ * 2) Use functions:
+ *
+ * 		KDI_Format_Int(buffer, -25, 4);				" -25"
+ * 		KDI_Format_Uint(buffer, 65535, 4);			"----"
+ * 		KDI_Format_Fixed(buffer, 1234, 2, 6);		" 12.34"	value 1234 with 2 decimal places
+ * 		KDI_Format_Float(buffer, 3.14159f, 3, 0);	"3.142"
+ *
+ * 3) For seven-segment indicators where the point is a segment of a digit,
+ * 	  define KDI_FORMAT_POINT_IN_DIGIT as 1, then the point is not counted in width.
+ *
+ */
+
+#ifndef KDI_FORMAT_H_
+#define KDI_FORMAT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes for fixed size integer types
+ */
+#include <stdint.h>
+
+/*
+ * @brief	Size of buffer enough for any number without alignment
+ */
+#define KDI_FORMAT_BUFFER_SIZE		16
+
+/*
+ * @brief	Character of the decimal point
+ */
+#ifndef KDI_FORMAT_POINT
+#define KDI_FORMAT_POINT			'.'
+#endif
+
+/*
+ * @brief	1 - point is not counted in width (seven-segment indicators), 0 - point takes one character
+ */
+#ifndef KDI_FORMAT_POINT_IN_DIGIT
+#define KDI_FORMAT_POINT_IN_DIGIT	0
+#endif
+
+/*
+ * @brief	Character of the overflow
+ */
+#ifndef KDI_FORMAT_OVERFLOW
+#define KDI_FORMAT_OVERFLOW			'-'
+#endif
+
+/*Functions convert numbers to string, return length of the string */
+uint8_t KDI_Format_Int(char* buffer, int32_t value, uint8_t width);
+uint8_t KDI_Format_Uint(char* buffer, uint32_t value, uint8_t width);
+uint8_t KDI_Format_Fixed(char* buffer, int32_t value, uint8_t decimals, uint8_t width);
+uint8_t KDI_Format_Float(char* buffer, float value, uint8_t decimals, uint8_t width);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_FORMAT_H_ */
@@ -138,6 +138,16 @@
 
 #include "KDI_Menu.h"
 
+/**
+ * @brief Includes for measure of time, by default it is off
+ */
+#include "KDI_Menu_Prof.h"
+
+/**
+ * @brief Includes table of functions of types of data
+ */
+#include "KDI_Menu_Type.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -152,42 +162,98 @@ extern "C" {
   * @param  	Pointer on KDI_Menu
   *	@return		Nope
   *
+  * @note		Nothing is printed if the item and its value are the same as in the last call.
   */
 
 void KDI_Menu_Handler(KDI_Menu* menu){
 
-	/*Check type data */
-	switch(menu->pointer->type){
+	KDI_MENU_PROF_ENTER();
 
-	/*For char data */
-	case TYPE_DATA_CHAR:
+	/* Current item */
+	KDI_Menu_item* item = menu->pointer;
 
-		/*print data*/
-		menu->print_string((char*)menu->pointer->data);
-		break;
+	/* Save value of item and check changes */
+	uint8_t changed = KDI_Menu_Update_Item(menu, item, &menu->shown_value);
 
-	/*For integer data */
-	case TYPE_DATA_INT:
+	/* Print only changed item or value*/
+	if(changed || item != menu->shown_item) KDI_Menu_Print_Item(menu, item);
 
-		/*print data*/
-		menu->print_int(*(int*)menu->pointer->data);
-		break;
+	/* Save displayed item*/
+	menu->shown_item = item;
 
-	/*For float data */
-	case TYPE_DATA_FLOAT:
+	KDI_MENU_PROF_EXIT(MENU_PROF_HANDLER);
+}
 
-		/*print data*/
-		menu->print_float(*(float*)menu->pointer->data);
-		break;
+/**
+  * @brief 		Displays data of any item
+  * @param  	Pointer on KDI_Menu
+  * @param  	Pointer on KDI_Menu_item
+  *	@return		Nope
+  */
 
-	/*For float data */
-	case TYPE_DATA_VOID:
+void KDI_Menu_Print_Item(KDI_Menu* menu, KDI_Menu_item* item){
 
-		/*print on display "Error 0" */
-		menu->print_string("E0  ");
-		break;
+	/* Function of the type of data, see KDI_Menu_Type.c*/
+	const KDI_Menu_Type* type = &KDI_Menu_types[item->type];
+
+	/* Edited item prints the working copy*/
+	if(item == menu->edit.item && KDI_Menu_Edit_Active(menu)){
+
+		type->print_value(menu, item->data, menu->edit.value);
+		return;
 	}
 
+	type->print(menu, type, item->data);
+}
+
+/**
+  * @brief 		Save value of item and check changes
+  * @param  	Pointer on KDI_Menu_item
+  * @param  	Pointer on copy of the displayed value
+  *	@return		1 if the value is not the same as the copy
+  */
+
+uint8_t KDI_Menu_Update_Value(KDI_Menu_item* item, KDI_Menu_Value* shown){
+
+	/* Function of the type of data, see KDI_Menu_Type.c*/
+	const KDI_Menu_Type* type = &KDI_Menu_types[item->type];
+
+	return type->update(type, item->data, shown);
+}
+
+/**
+  * @brief 		Save value of item of the menu and check changes
+  * @param  	Pointer on KDI_Menu
+  * @param  	Pointer on KDI_Menu_item
+  * @param  	Pointer on copy of the displayed value
+  *	@return		1 if the value is not the same as the copy
+  *
+  * @note		For the edited item the working copy is checked instead of the variable.
+  */
+
+uint8_t KDI_Menu_Update_Item(KDI_Menu* menu, KDI_Menu_item* item, KDI_Menu_Value* shown){
+
+	/* Not edited item*/
+	if(item != menu->edit.item || !KDI_Menu_Edit_Active(menu)) return KDI_Menu_Update_Value(item, shown);
+
+	uint8_t changed = (menu->edit.value != shown->value_int32);
+
+	shown->value_int32 = menu->edit.value;
+
+	return changed;
+}
+
+/**
+  * @brief 		Print current item on the next handler call
+  * @param  	Pointer on KDI_Menu
+  *	@return		Nope
+  *
+  */
+
+void KDI_Menu_Redraw(KDI_Menu* menu){
+
+	/* Forget displayed item*/
+	menu->shown_item = 0;
 }
 
 /**
@@ -202,6 +268,54 @@ void KDI_Menu_Start(KDI_Menu* menu){
 	/*Pointer points to the first element  */
 	menu->pointer = menu->Head;
 
+	/* Menu level is the level of the first element*/
+	menu->level = KDI_MenuItem_GetLevel(menu->Head);
+
+#if KDI_MENU_BREADCRUMB
+	/* No parents*/
+	menu->depth = 0;
+#endif
+
+	KDI_MENU_PUBLISH(menu);
+
+}
+
+/**
+  * @brief 		Get new item for the menu
+  * @param  	Pointer on KDI_Menu
+  *	@return		Pointer on item from the arena of the menu or from the pool, 0 if there is no free memory
+  */
+
+static KDI_Menu_item* KDI_Menu_New_Item(KDI_Menu* menu){
+
+	/* Item from the pool*/
+	if(!menu->arena) return KDI_GetMenu_item();
+
+	/* Check arena*/
+	if(menu->arena_used >= menu->arena_size) return 0;
+
+	KDI_Menu_item* item = &menu->arena[menu->arena_used++];
+
+	/* Initialize the entire structure with zeros*/
+	item->child_item = 0;
+
+	item->data = 0;
+
+	item->last_item = 0;
+
+	item->next_item = 0;
+
+#if !KDI_MENU_BREADCRUMB
+	item->parent_item = 0;
+#endif
+
+	item->type = 0;
+
+	item->level_menu = 0;
+
+	item->id = 0;
+
+	return item;
 }
 
 /**
@@ -215,18 +329,25 @@ void KDI_Menu_Start(KDI_Menu* menu){
   *					@arg TYPE_DATA_CHAR;
   *					@arg TYPE_DATA_INT;
   *					@arg TYPE_DATA_FLOAT;
+  *					@arg TYPE_DATA_INT8 ... TYPE_DATA_WIDGET, see KDI_Type_data;
   *
-  *	@return		Nope
+  *	@return		MENU_STATUS_OK or MENU_STATUS_NO_MEMORY
   *
   * @note		This function initialization structure and create first
   * 			menu element, usually this is a parameter, and its
   * 			parameters is the name of the parameter, i.e. string (char*).
   */
 
-void KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type){
+KDI_Menu_Status KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type){
 
 	/* Create first element menu */
-	menu->pointer = KDI_GetMenu_item();
+	KDI_Menu_item* item = KDI_Menu_New_Item(menu);
+
+	/* Check memory*/
+	if(!item) return MENU_STATUS_NO_MEMORY;
+
+	/* Save first element as current*/
+	menu->pointer = item;
 
 	/* Start level menu*/
 	menu->level = MENU_LEVEL_1;
@@ -237,6 +358,26 @@ void KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type){
 	/* Save pointer on start menu */
 	menu->Head = menu->pointer;
 
+#if KDI_MENU_BREADCRUMB
+	/* No parents*/
+	menu->depth = 0;
+#endif
+
+	/* Nothing is displayed yet*/
+	menu->shown_item = 0;
+
+	/* First item has number 0*/
+	menu->item_count = 1;
+
+	/* Items are taken one by one*/
+	menu->packed = 0;
+
+	/* Edit mode is off*/
+	menu->edit.item = 0;
+
+	/* Numbers without alignment*/
+	KDI_Menu_Set_Format(menu, 0, KDI_MENU_FLOAT_DECIMALS);
+
 	/* Save pointer on next item*/
 	KDI_MenuItem_SetLinkOnNextMenuItem(menu->pointer, menu->pointer);
 
@@ -252,9 +393,183 @@ void KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type){
 	/* Save menu level*/
 	KDI_MenuItem_SetLevel(menu->pointer, MENU_LEVEL_1);
 
+	KDI_MENU_PUBLISH(menu);
+
+	return MENU_STATUS_OK;
 }
 
 
+/**
+  * @brief 		Initialization structure with constant menu
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Pointer on first item of constant menu, see KDI_MENU_ITEM_CONST
+  *
+  *	@return		Nope
+  *
+  * @note		Items of the menu are only read, so the menu can be placed in flash.
+  * 			Do not use functions for creating menus with such menu.
+  * 			With index links the head must be the first item of the array.
+  */
+
+void KDI_Menu_Init_Const(KDI_Menu* menu, const KDI_Menu_item* head){
+
+	/* Save pointer on start menu, items are never written through it */
+	menu->Head = (KDI_Menu_item*)head;
+
+	/* Pointer points to the first element */
+	menu->pointer = menu->Head;
+
+	/* Nothing is displayed yet*/
+	menu->shown_item = 0;
+
+	/* Edit mode is off*/
+	menu->edit.item = 0;
+
+	/* Items are not created*/
+	menu->item_count = 0;
+
+	/* Start level menu*/
+	menu->level = KDI_MenuItem_GetLevel(menu->Head);
+
+	/* Numbers without alignment*/
+	KDI_Menu_Set_Format(menu, 0, KDI_MENU_FLOAT_DECIMALS);
+
+	/* Max level menu*/
+	menu->level_max = menu->level;
+
+	/* Links are indices in this array*/
+	KDI_MenuItem_SetArray(head);
+
+#if KDI_MENU_BREADCRUMB
+	/* No parents*/
+	menu->depth = 0;
+#endif
+
+	KDI_Menu_Walk walk;
+
+	/* Determination of the maximum level menu*/
+	for(KDI_Menu_item* item = KDI_MenuItem_Walk_Start(&walk, menu->Head); item; item = KDI_MenuItem_Walk_Next(&walk)){
+
+		if(KDI_MenuItem_GetLevel(item) > menu->level_max) menu->level_max = KDI_MenuItem_GetLevel(item);
+	}
+
+	/* Rings declared one after another are packed*/
+	KDI_Menu_Check_Packed(menu);
+
+	KDI_MENU_PUBLISH(menu);
+}
+
+/**
+  * @brief 		Save array of items for the menu
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Pointer on the first item of the array, 0 - items are taken from the pool
+  * @param		Number of items in the array
+  *
+  *	@return		Nope
+  *
+  * @note		Call it before KDI_Menu_Init. Functions for creating menus take items from the array
+  * 			one after another and return MENU_STATUS_NO_MEMORY when it is full.
+  */
+
+void KDI_Menu_Set_Arena(KDI_Menu* menu, KDI_Menu_item* arena, uint16_t size){
+
+	/* Save array*/
+	menu->arena = arena;
+
+	menu->arena_size = size;
+
+	/* All items are free*/
+	menu->arena_used = 0;
+}
+
+/**
+  * @brief 		Free all items of the menu
+  * @param  	Pointer on KDI_Menu
+  *	@return		Nope
+  *
+  * @note		Items from the pool are returned one by one, the tree is walked without recursion:
+  * 			rings are opened and each child is unlinked from its parent before going down,
+  * 			so the parent is freed after its children. Items of the arena are freed at once.
+  * 			Items of a constant menu are not changed. After this call use KDI_Menu_Init again.
+  * 			Windows and terminals of the menu keep pointers on freed items, call KDI_Menu_Window_Reset
+  * 			or KDI_Menu_Term_Reset for them after the menu is made again.
+  */
+
+void KDI_Menu_Destroy(KDI_Menu* menu){
+
+	KDI_Menu_item* item = menu->Head;
+
+#if KDI_MENU_BREADCRUMB
+	/* Parents of the current item*/
+	KDI_Menu_item* parents[MENU_LEVEL_MAX];
+
+	uint8_t depth = 0;
+#endif
+
+	if(menu->arena){
+
+		/* All arena items are free*/
+		menu->arena_used = 0;
+
+	}else if(menu->item_count && item){
+
+		/* Open the ring of the top level*/
+		KDI_MenuItem_SetLinkOnNextMenuItem(KDI_MENU_ITEM_LAST(item), 0);
+
+		while(item){
+
+			KDI_Menu_item* child = KDI_MENU_ITEM_CHILD(item);
+
+			/* Go down, open the ring of children*/
+			if(child){
+
+				KDI_MenuItem_SetLinkOnChildMenuItem(item, 0);
+
+				KDI_MenuItem_SetLinkOnNextMenuItem(KDI_MENU_ITEM_LAST(child), 0);
+
+#if KDI_MENU_BREADCRUMB
+				parents[depth++] = item;
+#endif
+
+				item = child;
+				continue;
+			}
+
+			/* Next item of the ring or the parent when the ring is ended*/
+#if KDI_MENU_BREADCRUMB
+			KDI_Menu_item* next = item->next_item ? KDI_MENU_ITEM_NEXT(item) : (depth ? parents[--depth] : 0);
+#else
+			KDI_Menu_item* next = item->next_item ? KDI_MENU_ITEM_NEXT(item) : KDI_MENU_ITEM_PARENT(item);
+#endif
+
+			KDI_FreeMenu_item(item);
+
+			item = next;
+		}
+	}
+
+	/* Menu is empty*/
+	menu->Head = 0;
+
+	menu->pointer = 0;
+
+	menu->shown_item = 0;
+
+	menu->item_count = 0;
+
+	menu->id_table = 0;
+
+	menu->id_table_size = 0;
+
+	menu->edit.item = 0;
+
+	menu->packed = 0;
+
+	KDI_MENU_PUBLISH(menu);
+}
+
 /**
   * @brief 		Add new menu item.
   *
@@ -266,6 +581,7 @@ void KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type){
   *					@arg TYPE_DATA_CHAR;
   *					@arg TYPE_DATA_INT;
   *					@arg TYPE_DATA_FLOAT;
+  *					@arg TYPE_DATA_INT8 ... TYPE_DATA_WIDGET, see KDI_Type_data;
   *
   *	@param		Menu navigation command.
   *				This parameter can be one of the KDI_Menu_Command enum values:
@@ -275,45 +591,60 @@ void KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type){
   *					@arg MENU_COMMAND_UP
   *					@arg MENU_COMMAND_DOWN
   *
-  *	@return		Nope
+  *	@return		MENU_STATUS_OK or MENU_STATUS_NO_MEMORY
   *
   * @note		This create new menu item, usually this is a parameter, and its
   * 			parameters is the name of the parameter, i.e. string (char*).
   */
 
 
-void KDI_Menu_Add_Next(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_Command command){
+KDI_Menu_Status KDI_Menu_Add_Next(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_Command command){
+
+	/* Create new menu item */
+	KDI_Menu_item* item = KDI_Menu_New_Item(menu);
+
+	/* Check memory*/
+	if(!item) return MENU_STATUS_NO_MEMORY;
+
+	/* New item is not in the packed ring*/
+	menu->packed = 0;
 
 	/* Copy pointer on head */
 	KDI_Menu_item* head = KDI_MenuItem_GetLinkOnNextMenuItem(menu->pointer);
 
-	/* Create new menu item and save pointer as next item*/
-	KDI_MenuItem_SetLinkOnNextMenuItem(menu->pointer, KDI_GetMenu_item());
+	/* Save pointer on new menu item as next item*/
+	KDI_MenuItem_SetLinkOnNextMenuItem(menu->pointer, item);
 
 	/* In new item save pointer on current item*/
-	KDI_MenuItem_SetLinkOnLastMenuItem(menu->pointer->next_item, menu->pointer);
+	KDI_MenuItem_SetLinkOnLastMenuItem(item, menu->pointer);
 
 	/* In new item save pointer on head*/
-	KDI_MenuItem_SetLinkOnNextMenuItem(menu->pointer->next_item, head);
+	KDI_MenuItem_SetLinkOnNextMenuItem(item, head);
 
 	/* In head save pointer on last item*/
-	KDI_MenuItem_SetLinkOnLastMenuItem(head, menu->pointer->next_item);
+	KDI_MenuItem_SetLinkOnLastMenuItem(head, item);
 
+#if !KDI_MENU_BREADCRUMB
 	/* In new item save pointer on common parent*/
-	KDI_MenuItem_SetLinkOnParentMenuItem(menu->pointer->next_item, menu->pointer->parent_item);
+	KDI_MenuItem_SetLinkOnParentMenuItem(item, KDI_MENU_ITEM_PARENT(menu->pointer));
+#endif
 
 	/* In new item save pointer on date*/
-	KDI_MenuItem_SetData(menu->pointer->next_item, data);
+	KDI_MenuItem_SetData(item, data);
 
 	/* In new item save type date*/
-	KDI_MenuItem_SetTypeData(menu->pointer->next_item, type);
+	KDI_MenuItem_SetTypeData(item, type);
 
 	/* In new item save menu level*/
-	KDI_MenuItem_SetLevel(menu->pointer->next_item, menu->level);
+	KDI_MenuItem_SetLevel(item, menu->level);
+
+	/* In new item save number*/
+	KDI_MenuItem_SetId(item, menu->item_count++);
 
 	/* Command execution */
 	if(command)	KDI_Menu_Drive(menu, command);
 
+	return MENU_STATUS_OK;
 }
 
 /**
@@ -330,6 +661,7 @@ void KDI_Menu_Add_Next(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_
   *					@arg TYPE_DATA_CHAR;
   *					@arg TYPE_DATA_INT;
   *					@arg TYPE_DATA_FLOAT;
+  *					@arg TYPE_DATA_INT8 ... TYPE_DATA_WIDGET, see KDI_Type_data;
   *
   *	@param		Defines the end of the menu, usually the data itself.
   *				This parameter can be one of the KDI_Menu_end enum values:
@@ -344,50 +676,74 @@ void KDI_Menu_Add_Next(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_
   *					@arg MENU_COMMAND_UP
   *					@arg MENU_COMMAND_DOWN
   *
-  *	@return		Nope
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NO_MEMORY or MENU_STATUS_LEVEL_ERROR if the current level is MENU_LEVEL_MAX
   *
   * @note		This create new menu item is child, this is a parameter or a date.
   * 			If its parameter used string (char*) and used MENU_NO_END.
   * 			if its date MENU_END.
   */
 
-void KDI_Menu_Add_Child(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_end end, KDI_Menu_Command command){
+KDI_Menu_Status KDI_Menu_Add_Child(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_end end, KDI_Menu_Command command){
 
-	/* Create new item and save pointer as child*/
-	KDI_MenuItem_SetLinkOnChildMenuItem(menu->pointer, KDI_GetMenu_item()); //Создание обьекта ребенка и сохранения указателя у родителя
+	/* Check depth of the menu*/
+	if(!end && menu->level >= MENU_LEVEL_MAX) return MENU_STATUS_LEVEL_ERROR;
+
+#if KDI_MENU_BREADCRUMB
+	/* The stack of parents must have place for going down*/
+	if(menu->depth >= KDI_MENU_BREADCRUMB_DEPTH) return MENU_STATUS_LEVEL_ERROR;
+#endif
+
+	/* Create new item */
+	KDI_Menu_item* item = KDI_Menu_New_Item(menu);
+
+	/* Check memory*/
+	if(!item) return MENU_STATUS_NO_MEMORY;
+
+	/* New item is not in the packed ring*/
+	menu->packed = 0;
+
+	/* Save pointer on new item as child*/
+	KDI_MenuItem_SetLinkOnChildMenuItem(menu->pointer, item); //Создание обьекта ребенка и сохранения указателя у родителя
 
 	/* In new item save pointer on a date*/
-	KDI_MenuItem_SetData(menu->pointer->child_item, data);				//Присвоение Указателя на данные
+	KDI_MenuItem_SetData(item, data);				//Присвоение Указателя на данные
 
 	/* In new item save type date*/
-	KDI_MenuItem_SetTypeData(menu->pointer->child_item, type);			//Присвоение типа данных
+	KDI_MenuItem_SetTypeData(item, type);			//Присвоение типа данных
 
 	/* In new item save pointer on next item*/
-	KDI_MenuItem_SetLinkOnNextMenuItem(menu->pointer->child_item, menu->pointer->child_item);
+	KDI_MenuItem_SetLinkOnNextMenuItem(item, item);
 
 	/* In new item save pointer on last item*/
-	KDI_MenuItem_SetLinkOnLastMenuItem(menu->pointer->child_item, menu->pointer->child_item);
+	KDI_MenuItem_SetLinkOnLastMenuItem(item, item);
 
 	/* Check end menu*/
 	if(end){
 
 		/* In new item set level as level data */
-		KDI_MenuItem_SetLevel(menu->pointer->child_item, MENU_LEVEL_DATA);
+		KDI_MenuItem_SetLevel(item, MENU_LEVEL_DATA);
 
 	}else{
 
 		/* In new item save increment level */
-		KDI_MenuItem_SetLevel(menu->pointer->child_item, menu->level + 1);
+		KDI_MenuItem_SetLevel(item, menu->level + 1);
 	}
 
+#if !KDI_MENU_BREADCRUMB
 	/* In new item save pointer on parent */
-	KDI_MenuItem_SetLinkOnParentMenuItem(menu->pointer->child_item, menu->pointer);	// ребенок получает указатель на родителя
+	KDI_MenuItem_SetLinkOnParentMenuItem(item, menu->pointer);	// ребенок получает указатель на родителя
+#endif
+
+	/* In new item save number*/
+	KDI_MenuItem_SetId(item, menu->item_count++);
 
 	/* Determination of the maximum level menu*/
-	if(KDI_MenuItem_GetLevel(menu->pointer->child_item) > menu->level_max) menu->level_max = menu->pointer->child_item->level_menu;
+	if(KDI_MenuItem_GetLevel(item) > menu->level_max) menu->level_max = KDI_MenuItem_GetLevel(item);
 
 	/* Command execution */
 	if(command)	KDI_Menu_Drive(menu, command);
+
+	return MENU_STATUS_OK;
 }
 
 /**
@@ -403,10 +759,27 @@ void KDI_Menu_Add_Child(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu
   *					@arg MENU_COMMAND_DOWN
   *
   *	@return		Nope
+  *
+  * @note		MENU_COMMAND_DOWN on the data level starts edit mode, see KDI_Menu_Edit.c.
+  * 			In edit mode forward and backward change the value, down writes it, up cancels.
   */
 
 void KDI_Menu_Drive(KDI_Menu* menu, KDI_Menu_Command command){
 
+	/* Commands of edit mode*/
+	if(KDI_Menu_Edit_Active(menu)){
+
+		if(command == MENU_COMMAND_FORWARD) KDI_Menu_Edit_Step(menu, 1);
+
+		if(command == MENU_COMMAND_BACKWARD) KDI_Menu_Edit_Step(menu, -1);
+
+		if(command == MENU_COMMAND_DOWN) KDI_Menu_Edit_Commit(menu);
+
+		if(command == MENU_COMMAND_UP) KDI_Menu_Edit_Cancel(menu);
+
+		return;
+	}
+
 	/* Check command*/
 	switch(command){
 
@@ -442,8 +815,15 @@ void KDI_Menu_Drive(KDI_Menu* menu, KDI_Menu_Command command){
 	/* Command Down*/
 	case MENU_COMMAND_DOWN:
 
-		/* Function command Down*/
-		KDI_Menu_Command_Down(menu);
+		/* On the data level start edit mode, else function command Down*/
+		if(menu->level == MENU_LEVEL_DATA){
+
+			KDI_Menu_Edit_Start(menu);
+
+		}else{
+
+			KDI_Menu_Command_Down(menu);
+		}
 		return;
 		break;
 
@@ -455,6 +835,415 @@ void KDI_Menu_Drive(KDI_Menu* menu, KDI_Menu_Command command){
 }
 
 
+/**
+  * @brief 		Save table of items by number
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Array of pointers on items, index is the number of item
+  * @param		Size of array
+  *	@return		Nope
+  *
+  * @note		Call after the menu is created, the table is filled by all items of the menu.
+  * 			Items with numbers not less than size are not saved.
+  */
+
+void KDI_Menu_Set_Id_Table(KDI_Menu* menu, KDI_Menu_item** table, uint16_t size){
+
+	/* Save table*/
+	menu->id_table = table;
+
+	menu->id_table_size = size;
+
+	/* Clear table*/
+	for(uint16_t i = 0; i < size; i++) table[i] = 0;
+
+	KDI_Menu_Walk walk;
+
+	/* Save all items of the menu*/
+	for(KDI_Menu_item* item = KDI_MenuItem_Walk_Start(&walk, menu->Head); item; item = KDI_MenuItem_Walk_Next(&walk)){
+
+		if(KDI_MenuItem_GetId(item) < size) table[KDI_MenuItem_GetId(item)] = item;
+	}
+}
+
+/**
+  * @brief 		Go to item by number
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Number of item
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND or MENU_STATUS_LEVEL_ERROR (see KDI_Menu_Jump_Item)
+  *
+  * @note		Uses the table saved by KDI_Menu_Set_Id_Table.
+  */
+
+KDI_Menu_Status KDI_Menu_Jump(KDI_Menu* menu, uint16_t id){
+
+	/* Check number*/
+	if(id >= menu->id_table_size || !menu->id_table[id]) return MENU_STATUS_NOT_FOUND;
+
+	/* Go to item*/
+	return KDI_Menu_Jump_Item(menu, menu->id_table[id]);
+}
+
+/**
+  * @brief 		Go to item
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Pointer on item of this menu
+  *	@return		MENU_STATUS_OK, with KDI_MENU_BREADCRUMB also MENU_STATUS_NOT_FOUND if the item is not
+  * 			in the tree or MENU_STATUS_LEVEL_ERROR if its parents are more than KDI_MENU_BREADCRUMB_DEPTH
+  *
+  * @note		With KDI_MENU_BREADCRUMB the parents are found by a walk of the tree from the head,
+  * 			so the time depends on the number of items. The current item is not changed on error.
+  */
+
+KDI_Menu_Status KDI_Menu_Jump_Item(KDI_Menu* menu, KDI_Menu_item* item){
+
+#if KDI_MENU_BREADCRUMB
+
+	KDI_Menu_Walk walk;
+
+	KDI_Menu_item* found = KDI_MenuItem_Walk_Start(&walk, menu->Head);
+
+	/* Find parents of item*/
+	while(found && found != item) found = KDI_MenuItem_Walk_Next(&walk);
+
+	if(!found) return MENU_STATUS_NOT_FOUND;
+
+	/* All parents must be in the stack, else Up and the path of the item are wrong*/
+	if(walk.depth > KDI_MENU_BREADCRUMB_DEPTH) return MENU_STATUS_LEVEL_ERROR;
+
+	for(menu->depth = 0; menu->depth < walk.depth; menu->depth++) menu->path[menu->depth] = KDI_MENU_ITEM_TO_LINK(walk.parents[menu->depth]);
+
+#endif
+
+	/* Save item as current*/
+	menu->pointer = item;
+
+	/* Menu level is the level of item*/
+	menu->level = KDI_MenuItem_GetLevel(item);
+
+	KDI_MENU_PUBLISH(menu);
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Compare name of item with part of path
+  *
+  * @param  	String of item
+  * @param		Name in path
+  * @param		Length of name
+  *	@return		1 if equal, spaces around the string of item are skipped
+  */
+
+static uint8_t KDI_Menu_Compare_Name(const char* string, const char* name, unsigned int length){
+
+	/* Skip spaces before*/
+	while(*string == ' ') string++;
+
+	/* Compare characters*/
+	for(unsigned int i = 0; i < length; i++){
+
+		if(string[i] != name[i]) return 0;
+	}
+
+	/* Skip spaces after*/
+	string += length;
+
+	while(*string == ' ') string++;
+
+	return *string == 0;
+}
+
+/**
+  * @brief 		Find item by path
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Path, names of items divided by '/', for example "B/B3"
+  *	@return		Pointer on item, 0 if not found
+  *
+  * @note		Names are compared with strings of items, see KDI_Menu_Type_Label.
+  */
+
+KDI_Menu_item* KDI_Menu_Find_Path(KDI_Menu* menu, const char* path){
+
+	/* First items of current level*/
+	KDI_Menu_item* first = menu->Head;
+
+	/* Found item*/
+	KDI_Menu_item* found = 0;
+
+	while(*path){
+
+		/* Length of the name*/
+		unsigned int length = 0;
+
+		while(path[length] && path[length] != '/') length++;
+
+		/* No items on this level*/
+		if(!first) return 0;
+
+		/* Find item in the ring*/
+		KDI_Menu_item* item = first;
+		found = 0;
+
+		do{
+			/* String of the item, also from binary image*/
+			const char* label = KDI_Menu_Type_Label(item);
+
+			if(label && KDI_Menu_Compare_Name(label, path, length)){
+
+				found = item;
+				break;
+			}
+
+			item = KDI_MENU_ITEM_NEXT(item);
+
+		}while(item && item != first);
+
+		if(!found) return 0;
+
+		/* Next name*/
+		path += length;
+
+		if(*path == '/') path++;
+
+		/* Next level*/
+		first = KDI_MENU_ITEM_CHILD(found);
+	}
+
+	return found;
+}
+
+/**
+  * @brief 		Go to item by path
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Path, names of items divided by '/', for example "B/B3"
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND or MENU_STATUS_LEVEL_ERROR (see KDI_Menu_Jump_Item)
+  */
+
+KDI_Menu_Status KDI_Menu_Jump_Path(KDI_Menu* menu, const char* path){
+
+	/* Find item*/
+	KDI_Menu_item* item = KDI_Menu_Find_Path(menu, path);
+
+	if(!item) return MENU_STATUS_NOT_FOUND;
+
+	/* Go to item*/
+	return KDI_Menu_Jump_Item(menu, item);
+}
+
+/**
+  * @brief 		Write path of the current item
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Buffer for the string
+  * @param		Size of the buffer with the end of the string
+  *	@return		Length of the string
+  *
+  * @note		Names of the parents and of the current item are divided by '/', spaces around them
+  * 			are skipped, items without string are not written. The string is cut if the buffer is small.
+  * 			Time depends only on the level of the current item.
+  */
+
+uint16_t KDI_Menu_Get_Path(KDI_Menu* menu, char* buffer, uint16_t size){
+
+	uint16_t length = 0;
+
+	if(!size) return 0;
+
+#if KDI_MENU_BREADCRUMB
+
+	/* Parents are in the stack*/
+	KDI_Menu_item* path[KDI_MENU_BREADCRUMB_DEPTH];
+
+	uint8_t depth = menu->depth;
+
+	for(uint8_t i = 0; i < depth; i++) path[i] = KDI_MENU_LINK_TO_ITEM(menu->path[i]);
+
+#else
+
+	/* Parents are found by links, the first is on the first level*/
+	KDI_Menu_item* path[MENU_LEVEL_MAX];
+
+	uint8_t depth = 0;
+
+	for(KDI_Menu_item* item = KDI_MENU_ITEM_PARENT(menu->pointer); item && depth < MENU_LEVEL_MAX; item = KDI_MENU_ITEM_PARENT(item)) depth++;
+
+	uint8_t number = depth;
+
+	for(KDI_Menu_item* item = KDI_MENU_ITEM_PARENT(menu->pointer); item && number; item = KDI_MENU_ITEM_PARENT(item)) path[--number] = item;
+
+#endif
+
+	for(uint8_t i = 0; i <= depth; i++){
+
+		const char* label = KDI_Menu_Type_Label((i < depth) ? path[i] : menu->pointer);
+
+		if(!label) continue;
+
+		/* Skip spaces before*/
+		while(*label == ' ') label++;
+
+		/* Skip spaces after*/
+		const char* end = label;
+
+		while(*end) end++;
+
+		while(end > label && end[-1] == ' ') end--;
+
+		/* Divider*/
+		if(length && length < size - 1U) buffer[length++] = '/';
+
+		while(label < end && length < size - 1U) buffer[length++] = *label++;
+	}
+
+	buffer[length] = 0;
+
+	return length;
+}
+
+/**
+  * @brief 		Move forward or backward by several items
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Number of items, positive - forward, negative - backward
+  *	@return		Nope
+  *
+  * @note		If the ring of items is passed completely, only the rest of the steps is done,
+  * 			by the shortest way. So the time does not depend on the number of steps.
+  * 			In edit mode the steps change the working copy of the value, see KDI_Menu_Edit_Step.
+  * 			In the packed layout (see KDI_Menu_Pack) the item is found by its number in the array.
+  */
+
+void KDI_Menu_Step(KDI_Menu* menu, int steps){
+
+	/* In edit mode steps change the value*/
+	if(KDI_Menu_Edit_Active(menu)){
+
+		KDI_Menu_Edit_Step(menu, steps);
+		return;
+	}
+
+	/* Packed ring, position is got by numbers*/
+	if(menu->packed){
+
+		KDI_Menu_item* first = KDI_Menu_Get_Pointer_First_Item(menu);
+
+		int count = (int)(KDI_MENU_ITEM_LAST(first) - first) + 1;
+
+		int position = (int)(menu->pointer - first) + steps % count;
+
+		/* Wrap around the ring*/
+		if(position < 0) position += count;
+		else if(position >= count) position -= count;
+
+		menu->pointer = first + position;
+
+		KDI_MENU_PUBLISH(menu);
+		return;
+	}
+
+	/* Start item*/
+	KDI_Menu_item* start = menu->pointer;
+
+	/* Current item*/
+	KDI_Menu_item* item = start;
+
+	/* Direction, 1 - forward*/
+	uint8_t forward = (steps > 0);
+
+	/* Number of moves*/
+	unsigned int moves = forward ? (unsigned int)steps : 0U - (unsigned int)steps;
+
+	/* Length of the ring*/
+	unsigned int length = 0;
+
+	/* Move until the end or the start item*/
+	while(moves){
+
+		item = forward ? KDI_MENU_ITEM_NEXT(item) : KDI_MENU_ITEM_LAST(item);
+
+		moves--;
+		length++;
+
+		if(item == start) break;
+	}
+
+	/* Ring is passed, do only the rest*/
+	if(moves){
+
+		moves %= length;
+
+		/* Other direction is shorter*/
+		if(moves > length / 2){
+
+			moves = length - moves;
+			forward = !forward;
+		}
+
+		while(moves--) item = forward ? KDI_MENU_ITEM_NEXT(item) : KDI_MENU_ITEM_LAST(item);
+	}
+
+	/* Save item as current*/
+	menu->pointer = item;
+
+	KDI_MENU_PUBLISH(menu);
+}
+
+/**
+  * @brief 		Add command to the sum of moves or execute it
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Sum of forward and backward commands not done yet
+  * @param		Command KDI_Menu_Command
+  *	@return		New sum of moves
+  *
+  * @note		Forward and backward commands are only added. Before other commands the sum is done
+  * 			by KDI_Menu_Step. Call KDI_Menu_Step with the returned sum after the last command.
+  * 			Used by KDI_Menu_Drive_Batch and KDI_Menu_Queue_Pump, so both join commands the same way.
+  */
+
+int KDI_Menu_Drive_Join(KDI_Menu* menu, int steps, KDI_Menu_Command command){
+
+	/* Add forward and backward commands*/
+	if(command == MENU_COMMAND_FORWARD) return steps + 1;
+
+	if(command == MENU_COMMAND_BACKWARD) return steps - 1;
+
+	/* Do added moves before other commands*/
+	KDI_Menu_Step(menu, steps);
+
+	KDI_Menu_Drive(menu, command);
+
+	return 0;
+}
+
+/**
+  * @brief 		Execute several commands
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Array of commands KDI_Menu_Command
+  * @param		Number of commands
+  *	@return		Nope
+  *
+  * @note		Forward and backward commands in a row are added together and done by KDI_Menu_Step,
+  * 			see KDI_Menu_Drive_Join. Call KDI_Menu_Handler once after this function.
+  */
+
+void KDI_Menu_Drive_Batch(KDI_Menu* menu, const KDI_Menu_Command* commands, unsigned int count){
+
+	/* Sum of forward and backward commands*/
+	int steps = 0;
+
+	for(unsigned int i = 0; i < count; i++) steps = KDI_Menu_Drive_Join(menu, steps, commands[i]);
+
+	/* Do the rest moves*/
+	KDI_Menu_Step(menu, steps);
+}
+
 /**
   * @brief 		Move on next item
   * @param  	Pointer on KDI_Menu
@@ -463,9 +1252,14 @@ void KDI_Menu_Drive(KDI_Menu* menu, KDI_Menu_Command command){
 
 void KDI_Menu_Command_Forward(KDI_Menu* menu){
 
+	KDI_MENU_PROF_ENTER();
+
 	/* Pointer next item save as main or current pointer */
-	menu->pointer = menu->pointer->next_item;
+	menu->pointer = KDI_MENU_ITEM_NEXT(menu->pointer);
 
+	KDI_MENU_PUBLISH(menu);
+
+	KDI_MENU_PROF_EXIT(MENU_PROF_FORWARD);
 }
 
 
@@ -477,9 +1271,14 @@ void KDI_Menu_Command_Forward(KDI_Menu* menu){
 
 void KDI_Menu_Command_Backward(KDI_Menu* menu){
 
+	KDI_MENU_PROF_ENTER();
+
 	/* Pointer last item save as main or current pointer */
-	menu->pointer = menu->pointer->last_item;
+	menu->pointer = KDI_MENU_ITEM_LAST(menu->pointer);
+
+	KDI_MENU_PUBLISH(menu);
 
+	KDI_MENU_PROF_EXIT(MENU_PROF_BACKWARD);
 }
 
 
@@ -494,41 +1293,34 @@ void KDI_Menu_Command_Backward(KDI_Menu* menu){
 
 void KDI_Menu_Command_Down(KDI_Menu* menu){
 
-	/* Check on unlimited level*/
-	if(menu->level < menu->level_max){
+	KDI_MENU_PROF_ENTER();
 
-		/* If level date then exit*/
-		if(menu->level == MENU_LEVEL_DATA) return;
+	/* Child of the current item*/
+	KDI_Menu_item* child = KDI_MENU_ITEM_CHILD(menu->pointer);
 
-		/* Increment level*/
-		menu->level++;
-
-		/* Check on unlimited level*/
-		if(menu->level > menu->level_max){
+#if KDI_MENU_BREADCRUMB
+	/* No place for the parent*/
+	if(menu->depth >= KDI_MENU_BREADCRUMB_DEPTH) child = 0;
+#endif
 
-			/* Save level as value level max*/
-			menu->level = menu->level_max;
+	/* Items of the data level and items without child have nothing below*/
+	if(menu->level != MENU_LEVEL_DATA && child){
 
-		}else {
+#if KDI_MENU_BREADCRUMB
+		/* Save parent*/
+		menu->path[menu->depth++] = KDI_MENU_ITEM_TO_LINK(menu->pointer);
+#endif
 
-			/* Pointer on child save as current pointer*/
-			menu->pointer = menu->pointer->child_item;
+		/* Pointer on child save as current pointer*/
+		menu->pointer = child;
 
-		}
-		return;
+		/* Menu level is the level of child*/
+		menu->level = KDI_MenuItem_GetLevel(child);
 	}
 
-	/* If the parent the child have level menu as data */
-	if(menu->pointer->child_item->level_menu == MENU_LEVEL_DATA){
-
-		/* Child pointer save as main pointer*/
-		menu->pointer = menu->pointer->child_item;
-
-		/* Menu level save as data level*/
-		menu->level = MENU_LEVEL_DATA;
-		return;
-	}
+	KDI_MENU_PUBLISH(menu);
 
+	KDI_MENU_PROF_EXIT(MENU_PROF_DOWN);
 }
 
 
@@ -543,36 +1335,29 @@ void KDI_Menu_Command_Down(KDI_Menu* menu){
 
 void KDI_Menu_Command_Up(KDI_Menu* menu){
 
-	/* Check on unlimited level*/
-	if(menu->level > 1){
+	KDI_MENU_PROF_ENTER();
 
-		/*decrement menu level*/
-		menu->level--;
+	/* Parent of the current item*/
+	KDI_Menu_item* parent = KDI_Menu_Get_Pointer_Parent_Item(menu);
 
-		/* Cheak level */
-		if(menu->level < 0){
-			menu->level = 1;
-		}
-		else{
+	/* Items of the first level have no parent*/
+	if(parent){
 
-			/* Parent pointer save as main pointer*/
-			menu->pointer = menu->pointer->parent_item;
-		}
-		return;
-	}
-
-	/* If the parent the child have level menu as data */
-	if(menu->level == MENU_LEVEL_DATA){
+#if KDI_MENU_BREADCRUMB
+		/* Remove parent from the stack*/
+		menu->depth--;
+#endif
 
 		/* Parent pointer save as main pointer*/
-		menu->pointer = menu->pointer->parent_item;
+		menu->pointer = parent;
 
-		/* Menu level save as data level*/
-		menu->level = menu->pointer->level_menu;
-		return;
+		/* Menu level is the level of parent*/
+		menu->level = KDI_MenuItem_GetLevel(parent);
 	}
 
+	KDI_MENU_PUBLISH(menu);
 
+	KDI_MENU_PROF_EXIT(MENU_PROF_UP);
 }
 
 /**
@@ -618,6 +1403,32 @@ void KDI_Menu_Set_print_float(KDI_Menu* menu, void(*point)(float)){
 	menu->print_float = point;
 }
 
+/**
+  * @brief 		Save format of numbers printed as strings
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Width of right alignment, 0 - no alignment. Numbers longer than width are printed as "----"
+  * @param		Number of decimal places of float
+  * @return 	Nope
+  *
+  * @note		Used only for int and float without print functions, see KDI_Menu_Set_print_int.
+  * 			Width is limited by KDI_FORMAT_BUFFER_SIZE.
+  */
+
+void KDI_Menu_Set_Format(KDI_Menu* menu, uint8_t width, uint8_t decimals){
+
+	/* Check width for buffer of KDI_Menu_Print_Item*/
+	if(width > KDI_FORMAT_BUFFER_SIZE - 2) width = KDI_FORMAT_BUFFER_SIZE - 2;
+
+	/* Save format*/
+	menu->format_width = width;
+
+	menu->format_decimals = decimals;
+
+	/* Print with new format on the next call*/
+	KDI_Menu_Redraw(menu);
+}
+
 /**
   * @brief 		Get pointer on current item
   *
@@ -641,7 +1452,7 @@ KDI_Menu_item* KDI_Menu_Get_Pointer_Current_Item(KDI_Menu* menu){
 KDI_Menu_item* KDI_Menu_Get_Pointer_Next_Item(KDI_Menu* menu){
 
 	/* Return pointer on next menu item*/
-	return menu->pointer->next_item;
+	return KDI_MENU_ITEM_NEXT(menu->pointer);
 }
 
 /**
@@ -654,7 +1465,7 @@ KDI_Menu_item* KDI_Menu_Get_Pointer_Next_Item(KDI_Menu* menu){
 KDI_Menu_item* KDI_Menu_Get_Pointer_Last_Item(KDI_Menu* menu){
 
 	/* Return pointer on last menu item*/
-	return menu->pointer->last_item;
+	return KDI_MENU_ITEM_LAST(menu->pointer);
 }
 
 /**
@@ -667,7 +1478,22 @@ KDI_Menu_item* KDI_Menu_Get_Pointer_Last_Item(KDI_Menu* menu){
 KDI_Menu_item* KDI_Menu_Get_Pointer_Child_Item(KDI_Menu* menu){
 
 	/* Return pointer on child menu item*/
-	return menu->pointer->child_item;
+	return KDI_MENU_ITEM_CHILD(menu->pointer);
+}
+
+/**
+  * @brief 		Get pointer on first item of the current ring
+  *
+  * @param  	Pointer on KDI_Menu
+  * @return 	Child of the parent, head on the first level
+  */
+
+KDI_Menu_item* KDI_Menu_Get_Pointer_First_Item(KDI_Menu* menu){
+
+	KDI_Menu_item* parent = KDI_Menu_Get_Pointer_Parent_Item(menu);
+
+	/* Return pointer on first menu item of the ring*/
+	return parent ? KDI_MENU_ITEM_CHILD(parent) : menu->Head;
 }
 
 /**
@@ -679,8 +1505,13 @@ KDI_Menu_item* KDI_Menu_Get_Pointer_Child_Item(KDI_Menu* menu){
 
 KDI_Menu_item* KDI_Menu_Get_Pointer_Parent_Item(KDI_Menu* menu){
 
+#if KDI_MENU_BREADCRUMB
+	/* Return the last saved parent*/
+	return menu->depth ? KDI_MENU_LINK_TO_ITEM(menu->path[menu->depth - 1]) : 0;
+#else
 	/* Return pointer on parent menu item*/
-	return menu->pointer->parent_item;
+	return KDI_MENU_ITEM_PARENT(menu->pointer);
+#endif
 }
 
 #ifdef __cplusplus
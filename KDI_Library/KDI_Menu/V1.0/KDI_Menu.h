@@ -16,6 +16,67 @@
  * 4) Use functions KDI_Menu_Start for start menu.
  * 5) To move through the menu use functions  KDI_Menu_Drive and call a KDI_Menu_Handler.
  *
+ * For fast encoders use KDI_Menu_Step with the number of steps, or KDI_Menu_Drive_Batch with all received commands,
+ * then call KDI_Menu_Handler once. Forward and backward moves are added together and done in one pass.
+ *
+ * Every item has a number (KDI_MenuItem_GetId), functions for creating menus give numbers 0, 1, 2 ...
+ * in the order of creating, so numbers are the same after each start. After the menu is created
+ * give a table of KDI_Menu_item* to KDI_Menu_Set_Id_Table, then KDI_Menu_Jump goes to any item by number at once.
+ * KDI_Menu_Jump_Path goes to the item by names of items, for example "B/B3", spaces around names are skipped.
+ *
+ * KDI_Menu_Handler prints only if the current item or its value changed since the last call,
+ * so it can be called in the main loop. Use KDI_Menu_Redraw to print again on the next call,
+ * for example after the display was cleared or a string was changed in place.
+ *
+ * Items can show string, int, float, int8_t ... uint32_t, bool, enum with labels and fixed-point variables,
+ * or be printed by own function of the item (TYPE_DATA_WIDGET), see KDI_Type_data. Variables are read in place, each type has its functions in the table KDI_Menu_types (KDI_Menu_Type.c).
+ *
+ * Values of items on the data level can be changed in edit mode:
+ * 		MENU_COMMAND_DOWN on the data level		-	start edit mode, the value is copied;
+ * 		MENU_COMMAND_FORWARD / BACKWARD			-	change the copy by the step, the value is printed from the copy;
+ * 		MENU_COMMAND_DOWN						-	write the copy to the variable and end edit mode;
+ * 		MENU_COMMAND_UP							-	end edit mode without writing.
+ * If the time function is set by KDI_Menu_Set_Time, fast steps in a row are multiplied by 10, 100 ...
+ * Limits are the range of the type or of KDI_Menu_Number, see KDI_Menu_item.h. Float and strings are not edited.
+ *
+ * If print functions of int or float are not set, numbers are converted to strings by KDI_Format
+ * and printed with the print function of string, so the display driver prints only strings.
+ * Use KDI_Menu_Set_Format to set width of right alignment and number of decimal places of float.
+ *
+ * A constant menu declared with KDI_MENU_ITEM_CONST (see KDI_Menu_item.h) is started with KDI_Menu_Init_Const
+ * instead of points 2 - 4, then only the structure KDI_Menu is placed in RAM.
+ *
+ * Functions for creating menus return MENU_STATUS_NO_MEMORY if the menu item pool is empty,
+ * in this case the menu is not changed. See KDI_MENU_POOL_SIZE in KDI_Menu_item.h.
+ * Menus have up to MENU_LEVEL_MAX (32) levels above the data level, KDI_Menu_Add_Child returns
+ * MENU_STATUS_LEVEL_ERROR for a deeper item. MENU_COMMAND_DOWN and MENU_COMMAND_UP follow the links
+ * of the current item and take the level from the item, so a step does not depend on the depth of the menu.
+ *
+ * To make the menu again call KDI_Menu_Destroy before KDI_Menu_Init, it returns all items of the menu
+ * to the pool walking the links without recursion. Items of one menu can also be taken from an own array
+ * given by KDI_Menu_Set_Arena before KDI_Menu_Init, then KDI_Menu_Destroy only resets the array.
+ * With index links (KDI_MENU_ITEM_LINK_BITS) the arena must be the array given to KDI_MenuItem_SetArray.
+ * KDI_Menu_Window and KDI_Menu_Term keep pointers on items, after KDI_Menu_Destroy call KDI_Menu_Window_Reset
+ * or KDI_Menu_Term_Reset for them.
+ *
+ * With RTOS one task moves the menu (KDI_Menu_Drive, KDI_Menu_Step ...), other tasks must not read
+ * the structure KDI_Menu. Define KDI_MENU_SNAPSHOT as 1, then each change of the menu saves current item,
+ * level and edit mode under a sequence number (seqlock), and KDI_Menu_Snapshot_Read gives them to any task
+ * at one moment. Writing never waits, reading is repeated only if it was at the same time with writing.
+ *
+ * KDI_Menu_Get_Path writes names of the parents and of the current item, for example "B/B3" for a header line,
+ * the string can be given to KDI_Menu_Jump_Path. With KDI_MENU_BREADCRUMB (see KDI_Menu_item.h) items have no
+ * link on parent: MENU_COMMAND_DOWN saves the current item in the stack of KDI_MENU_BREADCRUMB_DEPTH parents,
+ * MENU_COMMAND_UP takes it back. KDI_Menu_Jump_Item finds the parents by a walk from the head, so jumps
+ * (KDI_Menu_Jump, KDI_Menu_Jump_Path, KDI_Menu_Search_Jump) take time of the number of items in this mode,
+ * and return MENU_STATUS_LEVEL_ERROR without moving if the item has more parents than the stack keeps.
+ *
+ * KDI_Menu_Pack copies a created menu into an array of the program ring after ring, the first item of each ring
+ * is the child of its parent. Then KDI_Menu_Step, KDI_Menu_Get_Position and KDI_Menu_Jump_Sibling find items
+ * by numbers in the array instead of walking the ring, and walks of the tree read memory one item after another.
+ * A constant menu declared ring after ring is packed too, KDI_Menu_Init_Const checks it. Functions for creating menus
+ * end the packed layout, call KDI_Menu_Pack again after them. Old items are freed by KDI_Menu_Pack, so reset windows
+ * and terminals of the menu (KDI_Menu_Window_Reset, KDI_Menu_Term_Reset) and init KDI_Menu_Search and KDI_Menu_Cursor again.
  *
  */
 
@@ -33,6 +94,46 @@ extern "C" {
  */
 #include "KDI_Menu_item.h"
 
+/*
+ * @brief	Includes lib KDI_Format.h
+ * 			Numbers are converted to strings if print functions of int and float are not set
+ *
+ */
+#include "KDI_Format.h"
+
+/*
+ * @brief	Number of decimal places of float by default, see KDI_Menu_Set_Format
+ */
+#ifndef KDI_MENU_FLOAT_DECIMALS
+#define KDI_MENU_FLOAT_DECIMALS		2
+#endif
+
+/*
+ * @brief	Snapshot of current item for other tasks, 0 - off, 1 - on, see KDI_Menu_Snapshot_Read
+ */
+#ifndef KDI_MENU_SNAPSHOT
+#define KDI_MENU_SNAPSHOT			0
+#endif
+
+/*
+ * @brief	Number of parents kept by the menu if KDI_MENU_BREADCRUMB is 1, items with more parents can not be current
+ */
+#ifndef KDI_MENU_BREADCRUMB_DEPTH
+#define KDI_MENU_BREADCRUMB_DEPTH	MENU_LEVEL_MAX
+#endif
+
+/*
+ * @brief	Memory barriers between the sequence number and the snapshot: release for writing, acquire for reading.
+ * 			On one core Cortex-M a barrier of the compiler is enough.
+ */
+#if KDI_MENU_SNAPSHOT && !defined(KDI_MENU_BARRIER_RELEASE)
+#if defined(__GNUC__)
+#define KDI_MENU_BARRIER_RELEASE()	__atomic_thread_fence(__ATOMIC_RELEASE)
+#define KDI_MENU_BARRIER_ACQUIRE()	__atomic_thread_fence(__ATOMIC_ACQUIRE)
+#else
+#error "Define KDI_MENU_BARRIER_RELEASE() and KDI_MENU_BARRIER_ACQUIRE() as memory barriers for this compiler"
+#endif
+#endif
 
 /*
  * @brief	Menu command enumeration
@@ -58,6 +159,86 @@ typedef enum{
 
 }KDI_Menu_end;
 
+/*
+ * @brief	Status enumeration
+ */
+typedef enum{
+
+	MENU_STATUS_OK			=	0,
+	MENU_STATUS_NO_MEMORY	=	1,
+	MENU_STATUS_QUEUE_FULL	=	2,
+	MENU_STATUS_NOT_FOUND	=	3,
+	MENU_STATUS_IMAGE_ERROR	=	4,
+	MENU_STATUS_FLASH_ERROR	=	5,
+	MENU_STATUS_LEVEL_ERROR	=	6,
+
+}KDI_Menu_Status;
+
+/*
+ * @brief	Copy of the displayed value, used to print only changed values
+ */
+typedef union{
+
+	char* value_string;
+	int value_int;
+	int32_t value_int32;
+	float value_float;
+
+}KDI_Menu_Value;
+
+/*
+ * @brief	Time between steps of edit mode for acceleration, in units of the time function (see KDI_Menu_Set_Time)
+ */
+#ifndef KDI_MENU_EDIT_REPEAT_TIME
+#define KDI_MENU_EDIT_REPEAT_TIME		300
+#endif
+
+/*
+ * @brief	Number of fast steps in a row after which the step of edit mode is multiplied by 10
+ */
+#ifndef KDI_MENU_EDIT_ACCEL_STEPS
+#define KDI_MENU_EDIT_ACCEL_STEPS		8
+#endif
+
+/*
+ * @brief	State of edit mode
+ */
+typedef struct{
+
+	KDI_Menu_item* item;			/*!< Edited item, 0 - edit mode is off */
+
+	uint8_t repeat;					/*!< Number of fast steps in a row */
+
+	int8_t direction;				/*!< Direction of the last step, 1 or -1 */
+
+	int32_t value;					/*!< Working copy of the value */
+
+	int32_t min;					/*!< Minimum value */
+
+	int32_t max;					/*!< Maximum value */
+
+	int32_t step;					/*!< Change of the value by one command */
+
+	uint32_t time;					/*!< Time of the last step */
+
+}KDI_Menu_Edit;
+
+/*
+ * @brief	Current item, level and value at one moment, see KDI_Menu_Snapshot_Read
+ */
+
+typedef struct{
+
+	KDI_Menu_item* item;			/*!< Current item */
+
+	KDI_Menu_Level level;			/*!< Current menu level */
+
+	uint8_t editing;				/*!< 1 - the item is in edit mode */
+
+	int32_t value;					/*!< Working copy in edit mode, else value of the variable of the item */
+
+}KDI_Menu_Snapshot;
+
 /*
  * @brief	General structure for work library
  */
@@ -80,18 +261,89 @@ typedef struct Menu{
 
 	void(*print_float)(float );		/*!< Pointer of function print float and double */
 
+	KDI_Menu_item* shown_item;		/*!< Item displayed by the last handler call, 0 - redraw on next call */
+
+	KDI_Menu_Value shown_value;		/*!< Copy of the value displayed by the last handler call */
+
+	uint16_t item_count;			/*!< Number of items created by functions for creating menus */
+
+	KDI_Menu_item** id_table;		/*!< Table of items by number, see KDI_Menu_Set_Id_Table */
+
+	uint16_t id_table_size;			/*!< Size of the table of items by number */
+
+	uint8_t format_width;			/*!< Width of numbers converted to strings, 0 - no alignment */
+
+	uint8_t format_decimals;		/*!< Number of decimal places of float converted to string */
+
+	KDI_Menu_Edit edit;				/*!< State of edit mode */
+
+	uint32_t(*get_time)(void);		/*!< Pointer on function get time for acceleration of edit mode, 0 - no acceleration */
+
+	void(*commit)(void*, KDI_Menu_item*);	/*!< Pointer on function called after edit mode writes a value, 0 - no function */
+
+	void* commit_context;			/*!< First argument of the function commit */
+
+	KDI_Menu_item* arena;			/*!< Array of items of this menu, 0 - items are taken from the pool */
+
+	uint16_t arena_size;			/*!< Number of items in the arena */
+
+	uint16_t arena_used;			/*!< Number of used items of the arena */
+
+	uint8_t packed;					/*!< 1 - items of each ring are one after another in memory, see KDI_Menu_Pack */
+
+#if KDI_MENU_SNAPSHOT
+
+	volatile uint32_t sequence;		/*!< Odd while the snapshot is written */
+
+	volatile KDI_Menu_Snapshot snapshot;	/*!< Current item, level and edit mode after the last change */
+
+#endif
+
+#if KDI_MENU_BREADCRUMB
+
+	/* Stack of parents is the last, KDI_Menu_Cursor_Enter does not copy it*/
+	uint8_t depth;					/*!< Number of parents of the current item */
+
+	KDI_Menu_link path[KDI_MENU_BREADCRUMB_DEPTH];	/*!< Links on parents of the current item, the first is on the first level */
+
+#endif
+
 
 }KDI_Menu;
 
+/*
+ * @brief	Save snapshot after the menu is changed
+ */
+#if KDI_MENU_SNAPSHOT
+#define KDI_MENU_PUBLISH(menu)		KDI_Menu_Publish(menu)
+#else
+#define KDI_MENU_PUBLISH(menu)
+#endif
+
 /*Initialization function */
-void KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type);
+KDI_Menu_Status KDI_Menu_Init(KDI_Menu* menu, void* data, KDI_Type_data type);
+void KDI_Menu_Init_Const(KDI_Menu* menu, const KDI_Menu_item* head);
+void KDI_Menu_Set_Arena(KDI_Menu* menu, KDI_Menu_item* arena, uint16_t size);
+void KDI_Menu_Destroy(KDI_Menu* menu);
+
+/*Functions of the packed layout */
+KDI_Menu_Status KDI_Menu_Pack(KDI_Menu* menu, KDI_Menu_item* array, uint16_t size);
+uint8_t KDI_Menu_Check_Packed(KDI_Menu* menu);
+uint16_t KDI_Menu_Get_Position(KDI_Menu* menu, uint16_t* count);
+KDI_Menu_Status KDI_Menu_Jump_Sibling(KDI_Menu* menu, uint16_t number);
 
 /*Handler function */
 void KDI_Menu_Handler(KDI_Menu* menu);
+void KDI_Menu_Redraw(KDI_Menu* menu);
+
+/*Functions for output of any item, used by other displays */
+void KDI_Menu_Print_Item(KDI_Menu* menu, KDI_Menu_item* item);
+uint8_t KDI_Menu_Update_Value(KDI_Menu_item* item, KDI_Menu_Value* shown);
+uint8_t KDI_Menu_Update_Item(KDI_Menu* menu, KDI_Menu_item* item, KDI_Menu_Value* shown);
 
 /*Functions for creating menus*/
-void KDI_Menu_Add_Next(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_Command command);
-void KDI_Menu_Add_Child(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_end end, KDI_Menu_Command command);
+KDI_Menu_Status KDI_Menu_Add_Next(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_Command command);
+KDI_Menu_Status KDI_Menu_Add_Child(KDI_Menu* menu, void* data, KDI_Type_data type, KDI_Menu_end end, KDI_Menu_Command command);
 void KDI_Menu_Start(KDI_Menu* menu);
 
 /*Functions for moves menus*/
@@ -101,16 +353,44 @@ void KDI_Menu_Command_Backward(KDI_Menu* menu);
 void KDI_Menu_Command_Up(KDI_Menu* menu);
 void KDI_Menu_Command_Down(KDI_Menu* menu);
 
+/*Functions for jump to item*/
+void KDI_Menu_Set_Id_Table(KDI_Menu* menu, KDI_Menu_item** table, uint16_t size);
+KDI_Menu_Status KDI_Menu_Jump(KDI_Menu* menu, uint16_t id);
+KDI_Menu_Status KDI_Menu_Jump_Item(KDI_Menu* menu, KDI_Menu_item* item);
+KDI_Menu_item* KDI_Menu_Find_Path(KDI_Menu* menu, const char* path);
+KDI_Menu_Status KDI_Menu_Jump_Path(KDI_Menu* menu, const char* path);
+uint16_t KDI_Menu_Get_Path(KDI_Menu* menu, char* buffer, uint16_t size);
+
+/*Functions for many moves at once*/
+void KDI_Menu_Step(KDI_Menu* menu, int steps);
+int KDI_Menu_Drive_Join(KDI_Menu* menu, int steps, KDI_Menu_Command command);
+void KDI_Menu_Drive_Batch(KDI_Menu* menu, const KDI_Menu_Command* commands, unsigned int count);
+
+/*Functions of edit mode*/
+KDI_Menu_Status KDI_Menu_Edit_Start(KDI_Menu* menu);
+void KDI_Menu_Edit_Step(KDI_Menu* menu, int steps);
+void KDI_Menu_Edit_Commit(KDI_Menu* menu);
+void KDI_Menu_Edit_Cancel(KDI_Menu* menu);
+uint8_t KDI_Menu_Edit_Active(KDI_Menu* menu);
+void KDI_Menu_Set_Time(KDI_Menu* menu, uint32_t(*get_time)(void));
+void KDI_Menu_Set_Commit(KDI_Menu* menu, void(*commit)(void*, KDI_Menu_item*), void* context);
+
+/*Functions of snapshot for other tasks */
+void KDI_Menu_Publish(KDI_Menu* menu);
+void KDI_Menu_Snapshot_Read(const KDI_Menu* menu, KDI_Menu_Snapshot* snapshot);
+
 /*Functions to pass pointer to data output */
 void KDI_Menu_Set_print_char(KDI_Menu* menu, void(*point)(char*));
 void KDI_Menu_Set_print_int(KDI_Menu* menu, void(*point)(int));
 void KDI_Menu_Set_print_float(KDI_Menu* menu, void(*point)(float));
+void KDI_Menu_Set_Format(KDI_Menu* menu, uint8_t width, uint8_t decimals);
 
 /*Function get pointer on MenuItem*/
 KDI_Menu_item* KDI_Menu_Get_Pointer_Current_Item(KDI_Menu* menu);
 KDI_Menu_item* KDI_Menu_Get_Pointer_Next_Item(KDI_Menu* menu);
 KDI_Menu_item* KDI_Menu_Get_Pointer_Last_Item(KDI_Menu* menu);
 KDI_Menu_item* KDI_Menu_Get_Pointer_Child_Item(KDI_Menu* menu);
+KDI_Menu_item* KDI_Menu_Get_Pointer_First_Item(KDI_Menu* menu);
 KDI_Menu_item* KDI_Menu_Get_Pointer_Parent_Item(KDI_Menu* menu);
 
 #ifdef __cplusplus
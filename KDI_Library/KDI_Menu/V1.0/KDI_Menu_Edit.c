@@ -0,0 +1,213 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Edit.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of edit mode of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for change values of items on the data level.
+ * The value is copied when edit mode starts, commands change only the copy and the handler prints the copy.
+ * The variable is written once, when the copy is committed. Limits of the value are given by the function
+ * edit of the type of the item (see KDI_Menu_Type.c).
+ *
+ * Acceleration: if the time function is set, steps in one direction with less than KDI_MENU_EDIT_REPEAT_TIME
+ * between them are counted. After every KDI_MENU_EDIT_ACCEL_STEPS such steps the step is multiplied by 10,
+ * while ten steps are not more than the range of the value. So 0 ... 65535 takes about 90 steps of a held button.
+ *
+ */
+
+#include "KDI_Menu_Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief 		Start edit mode for current item
+  * @param  	Pointer on KDI_Menu
+  *	@return		MENU_STATUS_OK or MENU_STATUS_NOT_FOUND if the item is not on the data level or can not be edited
+  */
+
+KDI_Menu_Status KDI_Menu_Edit_Start(KDI_Menu* menu){
+
+	KDI_Menu_item* item = menu->pointer;
+
+	/* Only items of the data level*/
+	if(menu->level != MENU_LEVEL_DATA) return MENU_STATUS_NOT_FOUND;
+
+	const KDI_Menu_Type* type = &KDI_Menu_types[item->type];
+
+	/* Save limits, check that the type can be edited*/
+	if(!type->edit(item->data, &menu->edit)) return MENU_STATUS_NOT_FOUND;
+
+	/* Working copy*/
+	menu->edit.value = type->read(item->data);
+
+	menu->edit.repeat = 0;
+
+	menu->edit.direction = 0;
+
+	menu->edit.item = item;
+
+	KDI_MENU_PUBLISH(menu);
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Check edit mode
+  * @param  	Pointer on KDI_Menu
+  *	@return		1 if current item is edited
+  *
+  * @note		If current item was changed by a jump, edit mode is ended without writing.
+  */
+
+uint8_t KDI_Menu_Edit_Active(KDI_Menu* menu){
+
+	if(!menu->edit.item) return 0;
+
+	/* Current item is not the edited item*/
+	if(menu->edit.item != menu->pointer){
+
+		menu->edit.item = 0;
+
+		KDI_MENU_PUBLISH(menu);
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+  * @brief 		Change working copy
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Number of steps, less than 0 - decrease
+  *	@return		Nope
+  *
+  * @note		Value is limited by minimum and maximum.
+  */
+
+void KDI_Menu_Edit_Step(KDI_Menu* menu, int steps){
+
+	KDI_Menu_Edit* edit = &menu->edit;
+
+	if(!steps || !KDI_Menu_Edit_Active(menu)) return;
+
+	int8_t direction = (steps > 0) ? 1 : -1;
+
+	/* Multiplier of the step*/
+	int64_t multiplier = 1;
+
+	if(menu->get_time){
+
+		uint32_t time = menu->get_time();
+
+		/* Count fast steps in one direction*/
+		if(direction == edit->direction && time - edit->time < KDI_MENU_EDIT_REPEAT_TIME){
+
+			if(edit->repeat < UINT8_MAX) edit->repeat++;
+
+		}else{
+
+			edit->repeat = 0;
+		}
+
+		edit->time = time;
+
+		/* Multiply by 10 while ten steps are inside the range*/
+		int64_t range = (int64_t)edit->max - edit->min;
+
+		for(uint8_t i = edit->repeat / KDI_MENU_EDIT_ACCEL_STEPS; i; i--){
+
+			if((int64_t)edit->step * multiplier * 100 > range) break;
+
+			multiplier *= 10;
+		}
+	}
+
+	edit->direction = direction;
+
+	/* New value inside limits*/
+	int64_t value = (int64_t)edit->value + (int64_t)steps * edit->step * multiplier;
+
+	if(value > edit->max) value = edit->max;
+
+	if(value < edit->min) value = edit->min;
+
+	edit->value = (int32_t)value;
+
+	KDI_MENU_PUBLISH(menu);
+}
+
+/**
+  * @brief 		Write working copy to the variable and end edit mode
+  * @param  	Pointer on KDI_Menu
+  *	@return		Nope
+  */
+
+void KDI_Menu_Edit_Commit(KDI_Menu* menu){
+
+	if(!KDI_Menu_Edit_Active(menu)) return;
+
+	KDI_Menu_item* item = menu->edit.item;
+
+	/* One write of the variable*/
+	KDI_Menu_types[item->type].write(item->data, menu->edit.value);
+
+	menu->edit.item = 0;
+
+	KDI_MENU_PUBLISH(menu);
+
+	/* Tell about the new value, for example to save it*/
+	if(menu->commit) menu->commit(menu->commit_context, item);
+}
+
+/**
+  * @brief 		End edit mode without writing
+  * @param  	Pointer on KDI_Menu
+  *	@return		Nope
+  */
+
+void KDI_Menu_Edit_Cancel(KDI_Menu* menu){
+
+	menu->edit.item = 0;
+
+	KDI_MENU_PUBLISH(menu);
+}
+
+/**
+  * @brief 		Save pointer on function get time
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Pointer on function type "uint32_t name_fuction(void)", for example time in milliseconds,
+  * 			0 - without acceleration
+  * @return 	Nope
+  */
+
+void KDI_Menu_Set_Time(KDI_Menu* menu, uint32_t(*get_time)(void)){
+
+	/* Save pointer on function*/
+	menu->get_time = get_time;
+}
+
+/**
+  * @brief 		Save pointer on function called after edit mode writes a value
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Pointer on function type "void name_fuction(void* context, KDI_Menu_item* item)", 0 - no function
+  * @param		First argument of the function, for example pointer on KDI_Menu_Store
+  * @return 	Nope
+  */
+
+void KDI_Menu_Set_Commit(KDI_Menu* menu, void(*commit)(void*, KDI_Menu_item*), void* context){
+
+	/* Save pointer on function*/
+	menu->commit = commit;
+
+	menu->commit_context = context;
+}
+
+#ifdef __cplusplus
+}
+#endif
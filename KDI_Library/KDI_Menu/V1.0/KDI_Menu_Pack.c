@@ -0,0 +1,302 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Pack.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of packed layout of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for place items of each ring one after another in one array.
+ *
+ * In the packed layout the first item of a ring is the child of the parent (the head on the first level)
+ * and the items of the ring follow it in the array in the order of the ring, so the last item of the ring
+ * is the link last of the first one:
+ *
+ * 		count		=	last - first + 1;
+ * 		position	=	pointer - first;
+ * 		item N		=	first + N.
+ *
+ * Links stay as they are, so all functions of the menu work without changes, only KDI_Menu_Step,
+ * KDI_Menu_Get_Position and KDI_Menu_Jump_Sibling use the numbers instead of walking the ring.
+ *
+ * KDI_Menu_Pack copies items in breadth-first order: the ring of the head, then the rings of children
+ * of the copied items one after another. While copying, the number of the copy is kept in the id
+ * of the old item, so links are changed without memory and search. Old items are freed at the end.
+ *
+ */
+
+#include "KDI_Menu_Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief 		Copy ring of items to the end of the array
+  *
+  * @param  	Array
+  * @param  	Number of used items of the array
+  * @param  	First item of the ring
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Pack_Ring(KDI_Menu_item* array, uint16_t* used, KDI_Menu_item* first){
+
+	KDI_Menu_item* item = first;
+
+	do{
+		/* Copy with old links and number*/
+		array[*used] = *item;
+
+		/* Old item keeps the number of the copy*/
+		item->id = *used;
+
+		(*used)++;
+
+		item = KDI_MENU_ITEM_NEXT(item);
+
+	}while(item && item != first);
+}
+
+/**
+  * @brief 		Link on the copy of the old item
+  *
+  * @param  	Array
+  * @param  	Old item, 0 - no link
+  *	@return		Link
+  */
+
+static KDI_Menu_link KDI_Menu_Pack_Link(KDI_Menu_item* array, const KDI_Menu_item* item){
+
+	if(!item) return KDI_MENU_NO_LINK;
+
+	(void)array;
+
+	return (KDI_Menu_link)KDI_MENU_LINK(array, item->id);
+}
+
+/**
+  * @brief 		Copy the menu into array in the packed layout
+  *
+  * @param  	Pointer on created KDI_Menu
+  * @param		Array for items
+  * @param		Number of items in the array
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NO_MEMORY if the array is small
+  * 			or MENU_STATUS_NOT_FOUND for a constant menu
+  *
+  * @note		Call after the menu is created. Current item, numbers of items and the table of numbers
+  * 			are kept, edit mode is ended. Pointers on old items must be made again: call KDI_Menu_Window_Reset
+  * 			or KDI_Menu_Term_Reset for windows and terminals of the menu, KDI_Menu_Search_Init and KDI_Menu_Cursor_Init.
+  * 			Old items are returned to the pool, the array becomes the arena of the menu (see KDI_Menu_Set_Arena).
+  * 			With index links the array becomes the array of links (KDI_MenuItem_SetArray).
+  */
+
+KDI_Menu_Status KDI_Menu_Pack(KDI_Menu* menu, KDI_Menu_item* array, uint16_t size){
+
+	/* Items of a constant menu are not changed*/
+	if(!menu->item_count || !menu->Head) return MENU_STATUS_NOT_FOUND;
+
+	KDI_Menu_Walk walk;
+
+	uint32_t count = 0;
+
+	/* Number of items*/
+	for(KDI_Menu_item* item = KDI_MenuItem_Walk_Start(&walk, menu->Head); item; item = KDI_MenuItem_Walk_Next(&walk)) count++;
+
+	if(count > size) return MENU_STATUS_NO_MEMORY;
+
+#if KDI_MENU_ITEM_LINK_BITS == 8
+	/* Index links have numbers up to 255*/
+	if(count > 255) return MENU_STATUS_NO_MEMORY;
+#endif
+
+	/* Copies in breadth-first order*/
+	uint16_t used = 0;
+
+	KDI_Menu_Pack_Ring(array, &used, menu->Head);
+
+	for(uint16_t i = 0; i < used; i++){
+
+		KDI_Menu_item* child = KDI_MENU_ITEM_CHILD(&array[i]);
+
+		if(child) KDI_Menu_Pack_Ring(array, &used, child);
+	}
+
+	/* Links on copies*/
+	for(uint16_t i = 0; i < used; i++){
+
+		KDI_Menu_item* copy = &array[i];
+
+		copy->next_item = KDI_Menu_Pack_Link(array, KDI_MENU_ITEM_NEXT(copy));
+
+		copy->last_item = KDI_Menu_Pack_Link(array, KDI_MENU_ITEM_LAST(copy));
+
+#if !KDI_MENU_BREADCRUMB
+		copy->parent_item = KDI_Menu_Pack_Link(array, KDI_MENU_ITEM_PARENT(copy));
+#endif
+
+		copy->child_item = KDI_Menu_Pack_Link(array, KDI_MENU_ITEM_CHILD(copy));
+	}
+
+	/* Copy of the current item*/
+	KDI_Menu_item* current = &array[menu->pointer->id];
+
+	/* Free old items, own array of the program is only left*/
+	if(!menu->arena){
+
+		KDI_Menu old = *menu;
+
+		KDI_Menu_Destroy(&old);
+	}
+
+	/* Array is the arena of the menu*/
+	KDI_MenuItem_SetArray(array);
+
+	menu->arena = array;
+
+	menu->arena_size = size;
+
+	menu->arena_used = used;
+
+	menu->Head = array;
+
+	/* Old items are not displayed and not edited*/
+	menu->shown_item = 0;
+
+	menu->edit.item = 0;
+
+	menu->packed = 1;
+
+	/* Table of numbers on copies*/
+	if(menu->id_table) KDI_Menu_Set_Id_Table(menu, menu->id_table, menu->id_table_size);
+
+	/* Current item, level and parents, the head if parents do not fit in the stack*/
+	if(KDI_Menu_Jump_Item(menu, current) != MENU_STATUS_OK) KDI_Menu_Jump_Item(menu, array);
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Check if the menu is in the packed layout
+  * @param  	Pointer on KDI_Menu
+  *	@return		1 - packed, the result is saved in the menu
+  *
+  * @note		Called by KDI_Menu_Init_Const, so a constant menu declared ring after ring is packed.
+  */
+
+uint8_t KDI_Menu_Check_Packed(KDI_Menu* menu){
+
+	KDI_Menu_Walk walk;
+
+	menu->packed = 0;
+
+	if(!menu->Head) return 0;
+
+	/* First item of the top ring is the first in memory*/
+	if(KDI_MENU_ITEM_LAST(menu->Head) < menu->Head) return 0;
+
+	for(KDI_Menu_item* item = KDI_MenuItem_Walk_Start(&walk, menu->Head); item; item = KDI_MenuItem_Walk_Next(&walk)){
+
+		KDI_Menu_item* next = KDI_MENU_ITEM_NEXT(item);
+
+		/* Next item follows, or the ring returns back once*/
+		if(!next || (next != item + 1 && next > item)) return 0;
+
+		/* First item of the ring of children is the first in memory*/
+		KDI_Menu_item* child = KDI_MENU_ITEM_CHILD(item);
+
+		if(child && KDI_MENU_ITEM_LAST(child) < child) return 0;
+	}
+
+	menu->packed = 1;
+
+	return 1;
+}
+
+/**
+  * @brief 		Get position of the current item in its ring
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Number of items of the ring, can be 0
+  *	@return		Position, 0 - first item (child of the parent or head)
+  *
+  * @note		For the packed layout the time does not depend on the ring, else the ring is walked.
+  */
+
+uint16_t KDI_Menu_Get_Position(KDI_Menu* menu, uint16_t* count){
+
+	KDI_Menu_item* first = KDI_Menu_Get_Pointer_First_Item(menu);
+
+	uint16_t position = 0;
+
+	uint16_t length = 0;
+
+	if(menu->packed){
+
+		/* Numbers of the array*/
+		position = (uint16_t)(menu->pointer - first);
+
+		length = (uint16_t)(KDI_MENU_ITEM_LAST(first) - first + 1);
+
+	}else{
+
+		/* Walk the ring*/
+		KDI_Menu_item* item = first;
+
+		do{
+			if(item == menu->pointer) position = length;
+
+			length++;
+
+			item = KDI_MENU_ITEM_NEXT(item);
+
+		}while(item && item != first);
+	}
+
+	if(count) *count = length;
+
+	return position;
+}
+
+/**
+  * @brief 		Go to item of the current ring by position
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Position, 0 - first item
+  *	@return		MENU_STATUS_OK or MENU_STATUS_NOT_FOUND if the ring is shorter
+  */
+
+KDI_Menu_Status KDI_Menu_Jump_Sibling(KDI_Menu* menu, uint16_t number){
+
+	KDI_Menu_item* first = KDI_Menu_Get_Pointer_First_Item(menu);
+
+	KDI_Menu_item* item = first;
+
+	if(menu->packed){
+
+		/* Item of the array*/
+		if(number > KDI_MENU_ITEM_LAST(first) - first) return MENU_STATUS_NOT_FOUND;
+
+		item = first + number;
+
+	}else{
+
+		/* Walk the ring*/
+		while(number--){
+
+			item = KDI_MENU_ITEM_NEXT(item);
+
+			if(!item || item == first) return MENU_STATUS_NOT_FOUND;
+		}
+	}
+
+	/* Same level and parents*/
+	menu->pointer = item;
+
+	KDI_MENU_PUBLISH(menu);
+
+	return MENU_STATUS_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,163 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Prof.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of measure of time of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for measure time of KDI_Menu_Handler and functions KDI_Menu_Command_x.
+ * For each function the number of calls, minimum, maximum and mean time are saved.
+ * By default the measure is off and the code is not compiled, see KDI_Menu_Prof.h.
+ *
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "KDI_Menu_Prof.h"
+
+#if KDI_MENU_PROFILE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 		Results of all measured functions
+ */
+static KDI_Menu_Prof_stat KDI_Menu_Prof_stats[MENU_PROF_COUNT];
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/**
+ * @brief 		Includes for clock_gettime
+ */
+#include <time.h>
+
+/**
+  * @brief 		Get time of the host
+  * @param  	Nope
+  *	@return		Time in nanoseconds, lower 32 bits
+  */
+
+uint32_t KDI_Menu_Prof_Host_Time(void){
+
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return (uint32_t)((uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec);
+}
+
+#endif
+
+/**
+  * @brief 		Initialization of measure
+  * @param  	Nope
+  *	@return		Nope
+  *
+  * @note		On Cortex-M3/M4/M7/M33 starts the cycle counter.
+  */
+
+void KDI_Menu_Prof_Init(void){
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+
+	/* CoreDebug->DEMCR, enable DWT*/
+	*(volatile uint32_t*)0xE000EDFCUL |= (1UL << 24);
+
+	/* DWT->CYCCNT, start from zero*/
+	*(volatile uint32_t*)0xE0001004UL = 0;
+
+	/* DWT->CTRL, enable cycle counter*/
+	*(volatile uint32_t*)0xE0001000UL |= 1UL;
+
+#endif
+
+	/* Clear results*/
+	KDI_Menu_Prof_Reset();
+}
+
+/**
+  * @brief 		Clear results of measure
+  * @param  	Nope
+  *	@return		Nope
+  */
+
+void KDI_Menu_Prof_Reset(void){
+
+	for(unsigned int i = 0; i < MENU_PROF_COUNT; i++){
+
+		KDI_Menu_Prof_stats[i].count = 0;
+
+		KDI_Menu_Prof_stats[i].min = UINT32_MAX;
+
+		KDI_Menu_Prof_stats[i].max = 0;
+
+		KDI_Menu_Prof_stats[i].sum = 0;
+	}
+}
+
+/**
+  * @brief 		Save one measure
+  *
+  * @param  	Measured function
+  * 			This parameter can be one of the KDI_Menu_Prof_point enum values
+  * @param		Time of the function
+  *	@return		Nope
+  */
+
+void KDI_Menu_Prof_Add(KDI_Menu_Prof_point point, uint32_t time){
+
+	KDI_Menu_Prof_stat* stat = &KDI_Menu_Prof_stats[point];
+
+	/* Save time*/
+	stat->count++;
+
+	stat->sum += time;
+
+	if(time < stat->min) stat->min = time;
+
+	if(time > stat->max) stat->max = time;
+}
+
+/**
+  * @brief 		Get results of measure
+  *
+  * @param  	Measured function
+  * 			This parameter can be one of the KDI_Menu_Prof_point enum values
+  * @param		Pointer on structure for results
+  *	@return		Nope
+  *
+  * @note		If the function was not called min is UINT32_MAX.
+  */
+
+void KDI_Menu_Prof_Get(KDI_Menu_Prof_point point, KDI_Menu_Prof_stat* stat){
+
+	/* Copy results*/
+	*stat = KDI_Menu_Prof_stats[point];
+}
+
+/**
+  * @brief 		Get mean time
+  *
+  * @param  	Measured function
+  * 			This parameter can be one of the KDI_Menu_Prof_point enum values
+  *	@return		Mean time, 0 if the function was not called
+  */
+
+uint32_t KDI_Menu_Prof_Get_Mean(KDI_Menu_Prof_point point){
+
+	KDI_Menu_Prof_stat* stat = &KDI_Menu_Prof_stats[point];
+
+	if(!stat->count) return 0;
+
+	return (uint32_t)(stat->sum / stat->count);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Prof.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of measure of time of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for measure time of KDI_Menu_Handler and functions KDI_Menu_Command_x.
+ * For each function the number of calls, minimum, maximum and mean time are saved.
+ * By default the measure is off and the code is not compiled.
+ *
+ * 									##### How to use this driver #####
+ * 1) Define KDI_MENU_PROFILE as 1 in the project settings.
+ * 2) Use function KDI_Menu_Prof_Init, on Cortex-M3/M4/M7/M33 it starts the cycle counter DWT->CYCCNT.
+ * 3) Use functions KDI_Menu_Prof_Get and KDI_Menu_Prof_Get_Mean to read results.
+ *
+ * 	Time source:
+ * 		Cortex-M3/M4/M7/M33		-	DWT->CYCCNT, time in cycles of the core.
+ * 		Linux and other host	-	clock_gettime, time in nanoseconds.
+ * 		Other					-	define KDI_MENU_PROF_TIME() as your 32 bit counter, for example a timer register.
+ *
+ */
+
+#ifndef KDI_MENU_PROF_H_
+#define KDI_MENU_PROF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes for fixed size integer types
+ */
+#include <stdint.h>
+
+/*
+ * @brief	Measure of time, 0 - off, 1 - on
+ */
+#ifndef KDI_MENU_PROFILE
+#define KDI_MENU_PROFILE		0
+#endif
+
+/*
+ * @brief	Measured functions enumeration
+ */
+
+typedef enum{
+
+	MENU_PROF_HANDLER		=	0,
+	MENU_PROF_FORWARD		=	1,
+	MENU_PROF_BACKWARD		=	2,
+	MENU_PROF_UP			=	3,
+	MENU_PROF_DOWN			=	4,
+
+	MENU_PROF_COUNT			=	5,
+
+}KDI_Menu_Prof_point;
+
+/*
+ * @brief	Results of measure of one function
+ */
+
+typedef struct Menu_Prof_stat{
+
+	uint32_t count;			/*!< Number of calls */
+
+	uint32_t min;			/*!< Minimum time */
+
+	uint32_t max;			/*!< Maximum time */
+
+	uint64_t sum;			/*!< Sum of all times */
+
+}KDI_Menu_Prof_stat;
+
+#if KDI_MENU_PROFILE
+
+/*
+ * @brief	Time source, 32 bit counter
+ */
+#ifndef KDI_MENU_PROF_TIME
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+#define KDI_MENU_PROF_TIME()		(*(volatile uint32_t*)0xE0001004UL)		/* DWT->CYCCNT */
+#elif defined(__unix__) || defined(__APPLE__)
+#define KDI_MENU_PROF_TIME()		KDI_Menu_Prof_Host_Time()
+uint32_t KDI_Menu_Prof_Host_Time(void);
+#else
+#error "Define KDI_MENU_PROF_TIME() as 32 bit counter for this microcontroller"
+#endif
+#endif
+
+/*
+ * @brief	Start and end of measure inside a function
+ */
+#define KDI_MENU_PROF_ENTER()		uint32_t kdi_menu_prof_start = KDI_MENU_PROF_TIME()
+#define KDI_MENU_PROF_EXIT(point)	KDI_Menu_Prof_Add((point), KDI_MENU_PROF_TIME() - kdi_menu_prof_start)
+
+/*Initialization function */
+void KDI_Menu_Prof_Init(void);
+void KDI_Menu_Prof_Reset(void);
+
+/*Function save one measure */
+void KDI_Menu_Prof_Add(KDI_Menu_Prof_point point, uint32_t time);
+
+/*Functions get results */
+void KDI_Menu_Prof_Get(KDI_Menu_Prof_point point, KDI_Menu_Prof_stat* stat);
+uint32_t KDI_Menu_Prof_Get_Mean(KDI_Menu_Prof_point point);
+
+#else
+
+#define KDI_MENU_PROF_ENTER()
+#define KDI_MENU_PROF_EXIT(point)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_PROF_H_ */
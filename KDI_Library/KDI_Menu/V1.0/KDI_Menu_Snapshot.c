@@ -0,0 +1,121 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Snapshot.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of snapshot of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for read current item of the menu from other tasks of RTOS without mutex.
+ *
+ * The task which moves the menu calls KDI_Menu_Publish after each change (functions of KDI_Menu do it).
+ * The sequence number is made odd, the snapshot is written, then the number is made even again.
+ * A reader copies the snapshot between two reads of the number and repeats if the number was odd
+ * or changed. So the writer never waits and the reader gets item, level and value of one moment.
+ *
+ * With KDI_MENU_SNAPSHOT 0 the snapshot is not saved and KDI_Menu_Snapshot_Read reads the menu directly,
+ * use it only in the task which moves the menu.
+ *
+ */
+
+#include "KDI_Menu_Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief 		Save snapshot of current item
+  * @param  	Pointer on KDI_Menu
+  *	@return		Nope
+  *
+  * @note		Only one task may change the menu.
+  */
+
+void KDI_Menu_Publish(KDI_Menu* menu){
+
+#if KDI_MENU_SNAPSHOT
+
+	uint32_t sequence = menu->sequence;
+
+	/* Odd number, writing*/
+	menu->sequence = sequence + 1;
+
+	KDI_MENU_BARRIER_RELEASE();
+
+	menu->snapshot.item = menu->pointer;
+
+	menu->snapshot.level = menu->level;
+
+	menu->snapshot.editing = menu->edit.item && menu->edit.item == menu->pointer;
+
+	menu->snapshot.value = menu->edit.value;
+
+	KDI_MENU_BARRIER_RELEASE();
+
+	/* Even number, done*/
+	menu->sequence = sequence + 2;
+
+#else
+
+	(void)menu;
+
+#endif
+}
+
+/**
+  * @brief 		Read current item, level and value at one moment
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param  	Pointer on KDI_Menu_Snapshot for result
+  *	@return		Nope
+  *
+  * @note		Can be called from any task. Outside edit mode the value is read from the variable
+  * 			of the item (see read functions of KDI_Menu_Type.c), strings and float give 0.
+  */
+
+void KDI_Menu_Snapshot_Read(const KDI_Menu* menu, KDI_Menu_Snapshot* snapshot){
+
+#if KDI_MENU_SNAPSHOT
+
+	uint32_t sequence;
+
+	do{
+		sequence = menu->sequence;
+
+		KDI_MENU_BARRIER_ACQUIRE();
+
+		snapshot->item = menu->snapshot.item;
+
+		snapshot->level = menu->snapshot.level;
+
+		snapshot->editing = menu->snapshot.editing;
+
+		snapshot->value = menu->snapshot.value;
+
+		KDI_MENU_BARRIER_ACQUIRE();
+
+	/* Repeat if the snapshot was written at the same time*/
+	}while((sequence & 1) || sequence != menu->sequence);
+
+#else
+
+	snapshot->item = menu->pointer;
+
+	snapshot->level = menu->level;
+
+	snapshot->editing = menu->edit.item && menu->edit.item == menu->pointer;
+
+	snapshot->value = menu->edit.value;
+
+#endif
+
+	/* Value of the variable, items are not changed*/
+	if(snapshot->item && !snapshot->editing){
+
+		snapshot->value = KDI_Menu_types[snapshot->item->type].read(snapshot->item->data);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif
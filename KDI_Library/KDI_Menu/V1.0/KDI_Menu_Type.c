@@ -0,0 +1,608 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Type.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of types of data of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for read and print data of items by the type of data (KDI_Type_data).
+ * All integer types are read as int32_t by their read function, then they are saved and printed
+ * by the same functions. Enum, fixed-point and number items read and write their variable by the functions
+ * of the type written in KDI_Menu_Enum, KDI_Menu_Fixed and KDI_Menu_Number. Widget items are printed by their own function.
+ * Items TYPE_DATA_IMAGE of a binary image find their string or bound data and call functions of its type.
+ *
+ * Errors printed on display:
+ * 		"E0  "	-	item without data (TYPE_DATA_VOID) or unknown type;
+ * 		"E1  "	-	value of enum has no label.
+ *
+ */
+
+#include "KDI_Menu_Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Includes for bool and limits of int
+ */
+#include <stdbool.h>
+#include <limits.h>
+
+/**
+  * @brief 		Read functions of integer types
+  * @param  	Pointer on the variable
+  *	@return		Value of the variable
+  */
+
+static int32_t KDI_Menu_Type_Read_Int(const void* data){ return (int32_t)*(const int*)data; }
+static int32_t KDI_Menu_Type_Read_Int8(const void* data){ return (int32_t)*(const int8_t*)data; }
+static int32_t KDI_Menu_Type_Read_Uint8(const void* data){ return (int32_t)*(const uint8_t*)data; }
+static int32_t KDI_Menu_Type_Read_Int16(const void* data){ return (int32_t)*(const int16_t*)data; }
+static int32_t KDI_Menu_Type_Read_Uint16(const void* data){ return (int32_t)*(const uint16_t*)data; }
+static int32_t KDI_Menu_Type_Read_Int32(const void* data){ return *(const int32_t*)data; }
+static int32_t KDI_Menu_Type_Read_Uint32(const void* data){ return (int32_t)*(const uint32_t*)data; }
+static int32_t KDI_Menu_Type_Read_Bool(const void* data){ return (int32_t)*(const bool*)data; }
+
+/**
+  * @brief 		Read functions of items with variable of integer type
+  * @param  	Pointer on the data of item
+  *	@return		Value of the variable
+  */
+
+static int32_t KDI_Menu_Type_Read_Enum(const void* data){
+
+	const KDI_Menu_Enum* item_enum = (const KDI_Menu_Enum*)data;
+
+	return KDI_Menu_types[item_enum->type].read(item_enum->value);
+}
+
+static int32_t KDI_Menu_Type_Read_Fixed(const void* data){
+
+	const KDI_Menu_Fixed* item_fixed = (const KDI_Menu_Fixed*)data;
+
+	return KDI_Menu_types[item_fixed->type].read(item_fixed->value);
+}
+
+static int32_t KDI_Menu_Type_Read_Number(const void* data){
+
+	const KDI_Menu_Number* number = (const KDI_Menu_Number*)data;
+
+	return KDI_Menu_types[number->type].read(number->value);
+}
+
+/**
+  * @brief 		Read function of not integer types
+  * @param  	Pointer on the data
+  *	@return		0
+  */
+
+static int32_t KDI_Menu_Type_Read_None(const void* data){
+
+	(void)data;
+
+	return 0;
+}
+
+/**
+  * @brief 		Write functions of integer types
+  *
+  * @param  	Pointer on the variable
+  * @param  	New value, must be inside the range of the type
+  *	@return		Nope
+  *
+  * @note		Variables are written through the pointer of the item, they must not be constant.
+  */
+
+static void KDI_Menu_Type_Write_Int(const void* data, int32_t value){ *(int*)data = (int)value; }
+static void KDI_Menu_Type_Write_Int8(const void* data, int32_t value){ *(int8_t*)data = (int8_t)value; }
+static void KDI_Menu_Type_Write_Uint8(const void* data, int32_t value){ *(uint8_t*)data = (uint8_t)value; }
+static void KDI_Menu_Type_Write_Int16(const void* data, int32_t value){ *(int16_t*)data = (int16_t)value; }
+static void KDI_Menu_Type_Write_Uint16(const void* data, int32_t value){ *(uint16_t*)data = (uint16_t)value; }
+static void KDI_Menu_Type_Write_Int32(const void* data, int32_t value){ *(int32_t*)data = value; }
+static void KDI_Menu_Type_Write_Uint32(const void* data, int32_t value){ *(uint32_t*)data = (uint32_t)value; }
+static void KDI_Menu_Type_Write_Bool(const void* data, int32_t value){ *(bool*)data = (value != 0); }
+
+/**
+  * @brief 		Write functions of items with variable of integer type
+  *
+  * @param  	Pointer on the data of item
+  * @param  	New value
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Type_Write_Enum(const void* data, int32_t value){
+
+	const KDI_Menu_Enum* item_enum = (const KDI_Menu_Enum*)data;
+
+	KDI_Menu_types[item_enum->type].write(item_enum->value, value);
+}
+
+static void KDI_Menu_Type_Write_Fixed(const void* data, int32_t value){
+
+	const KDI_Menu_Fixed* item_fixed = (const KDI_Menu_Fixed*)data;
+
+	KDI_Menu_types[item_fixed->type].write(item_fixed->value, value);
+}
+
+static void KDI_Menu_Type_Write_Number(const void* data, int32_t value){
+
+	const KDI_Menu_Number* number = (const KDI_Menu_Number*)data;
+
+	KDI_Menu_types[number->type].write(number->value, value);
+}
+
+/**
+  * @brief 		Write function of not integer types
+  *
+  * @param  	Pointer on the data
+  * @param  	New value
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Type_Write_None(const void* data, int32_t value){
+
+	(void)data; (void)value;
+}
+
+/**
+  * @brief 		Save limits of edit mode
+  *
+  * @param  	Pointer on the data of item
+  * @param  	Pointer on state of edit mode
+  *	@return		1 if the value can be edited, 0 - not
+  */
+
+static uint8_t KDI_Menu_Type_Edit_Range(KDI_Menu_Edit* edit, int32_t min, int32_t max){
+
+	edit->min = min;
+
+	edit->max = max;
+
+	edit->step = 1;
+
+	return 1;
+}
+
+static uint8_t KDI_Menu_Type_Edit_Int(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, INT_MIN, INT_MAX); }
+static uint8_t KDI_Menu_Type_Edit_Int8(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, INT8_MIN, INT8_MAX); }
+static uint8_t KDI_Menu_Type_Edit_Uint8(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, 0, UINT8_MAX); }
+static uint8_t KDI_Menu_Type_Edit_Int16(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, INT16_MIN, INT16_MAX); }
+static uint8_t KDI_Menu_Type_Edit_Uint16(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, 0, UINT16_MAX); }
+static uint8_t KDI_Menu_Type_Edit_Int32(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, INT32_MIN, INT32_MAX); }
+static uint8_t KDI_Menu_Type_Edit_Bool(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, 0, 1); }
+
+/* Working copy is int32_t, so uint32_t is edited only up to INT32_MAX*/
+static uint8_t KDI_Menu_Type_Edit_Uint32(const void* data, KDI_Menu_Edit* edit){ (void)data; return KDI_Menu_Type_Edit_Range(edit, 0, INT32_MAX); }
+
+static uint8_t KDI_Menu_Type_Edit_Enum(const void* data, KDI_Menu_Edit* edit){
+
+	const KDI_Menu_Enum* item_enum = (const KDI_Menu_Enum*)data;
+
+	/* Only values with label*/
+	if(!item_enum->count) return 0;
+
+	return KDI_Menu_Type_Edit_Range(edit, 0, item_enum->count - 1);
+}
+
+static uint8_t KDI_Menu_Type_Edit_Fixed(const void* data, KDI_Menu_Edit* edit){
+
+	const KDI_Menu_Fixed* item_fixed = (const KDI_Menu_Fixed*)data;
+
+	/* Range of the type of the variable*/
+	return KDI_Menu_types[item_fixed->type].edit(item_fixed->value, edit);
+}
+
+static uint8_t KDI_Menu_Type_Edit_Number(const void* data, KDI_Menu_Edit* edit){
+
+	const KDI_Menu_Number* number = (const KDI_Menu_Number*)data;
+
+	/* Variable must be integer*/
+	if(!KDI_Menu_types[number->type].edit(number->value, edit)) return 0;
+
+	KDI_Menu_Type_Edit_Range(edit, number->min, number->max);
+
+	if(number->step > 0) edit->step = number->step;
+
+	return 1;
+}
+
+static uint8_t KDI_Menu_Type_Edit_None(const void* data, KDI_Menu_Edit* edit){
+
+	(void)data; (void)edit;
+
+	return 0;
+}
+
+/**
+  * @brief 		Save value of item and check changes
+  *
+  * @param  	Functions of the type
+  * @param  	Pointer on the data of item
+  * @param  	Pointer on copy of the displayed value
+  *	@return		1 if the value is not the same as the copy
+  */
+
+static uint8_t KDI_Menu_Type_Update_None(const KDI_Menu_Type* type, const void* data, KDI_Menu_Value* shown){
+
+	(void)type; (void)data; (void)shown;
+
+	return 0;
+}
+
+static uint8_t KDI_Menu_Type_Update_String(const KDI_Menu_Type* type, const void* data, KDI_Menu_Value* shown){
+
+	(void)type;
+
+	/* The string is the same if the pointer is the same*/
+	uint8_t changed = ((char*)data != shown->value_string);
+
+	shown->value_string = (char*)data;
+
+	return changed;
+}
+
+static uint8_t KDI_Menu_Type_Update_Float(const KDI_Menu_Type* type, const void* data, KDI_Menu_Value* shown){
+
+	(void)type;
+
+	float value = *(const float*)data;
+
+	uint8_t changed = (value != shown->value_float);
+
+	shown->value_float = value;
+
+	return changed;
+}
+
+static uint8_t KDI_Menu_Type_Update_Integer(const KDI_Menu_Type* type, const void* data, KDI_Menu_Value* shown){
+
+	int32_t value = type->read(data);
+
+	uint8_t changed = (value != shown->value_int32);
+
+	shown->value_int32 = value;
+
+	return changed;
+}
+
+static uint8_t KDI_Menu_Type_Update_Widget(const KDI_Menu_Type* type, const void* data, KDI_Menu_Value* shown){
+
+	(void)type;
+
+	const KDI_Menu_Widget* widget = (const KDI_Menu_Widget*)data;
+
+	/* Widget and image data would call this function again, they are checked as TYPE_DATA_VOID*/
+	KDI_Type_data data_kind = (widget->type == TYPE_DATA_WIDGET || widget->type == TYPE_DATA_IMAGE) ? TYPE_DATA_VOID : widget->type;
+
+	/* Data is checked by functions of its type*/
+	const KDI_Menu_Type* data_type = &KDI_Menu_types[data_kind];
+
+	return data_type->update(data_type, widget->data, shown);
+}
+
+/**
+  * @brief 		Print value as the item
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param  	Pointer on the data of item
+  * @param  	Value
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Type_Value_None(KDI_Menu* menu, const void* data, int32_t value){
+
+	(void)data; (void)value;
+
+	/*print on display "Error 0" */
+	menu->print_string("E0  ");
+}
+
+static void KDI_Menu_Type_Value_Integer(KDI_Menu* menu, const void* data, int32_t value){
+
+	(void)data;
+
+	/* Without print function of int, or if int is too small, convert it to string*/
+	if(menu->print_int && (int32_t)(int)value == value){
+
+		menu->print_int((int)value);
+
+	}else{
+
+		char buffer[KDI_FORMAT_BUFFER_SIZE];
+
+		KDI_Format_Int(buffer, value, menu->format_width);
+		menu->print_string(buffer);
+	}
+}
+
+static void KDI_Menu_Type_Value_Uint32(KDI_Menu* menu, const void* data, int32_t value){
+
+	/* Values bigger than INT32_MAX are always converted to string*/
+	if(value < 0 || !menu->print_int){
+
+		char buffer[KDI_FORMAT_BUFFER_SIZE];
+
+		KDI_Format_Uint(buffer, (uint32_t)value, menu->format_width);
+		menu->print_string(buffer);
+
+	}else{
+
+		KDI_Menu_Type_Value_Integer(menu, data, value);
+	}
+}
+
+static void KDI_Menu_Type_Value_Bool(KDI_Menu* menu, const void* data, int32_t value){
+
+	(void)data;
+
+	menu->print_string(value ? KDI_MENU_BOOL_ON : KDI_MENU_BOOL_OFF);
+}
+
+static void KDI_Menu_Type_Value_Enum(KDI_Menu* menu, const void* data, int32_t value){
+
+	const KDI_Menu_Enum* item_enum = (const KDI_Menu_Enum*)data;
+
+	/* Value without label, print on display "Error 1" */
+	if(value < 0 || value >= item_enum->count){
+
+		menu->print_string("E1  ");
+		return;
+	}
+
+	menu->print_string((char*)item_enum->labels[value]);
+}
+
+static void KDI_Menu_Type_Value_Fixed(KDI_Menu* menu, const void* data, int32_t value){
+
+	const KDI_Menu_Fixed* item_fixed = (const KDI_Menu_Fixed*)data;
+
+	char buffer[KDI_FORMAT_BUFFER_SIZE];
+
+	KDI_Format_Fixed(buffer, value, item_fixed->decimals, menu->format_width);
+	menu->print_string(buffer);
+}
+
+static void KDI_Menu_Type_Value_Number(KDI_Menu* menu, const void* data, int32_t value){
+
+	const KDI_Menu_Number* number = (const KDI_Menu_Number*)data;
+
+	/* Integer is printed as the type of the variable*/
+	if(!number->decimals){
+
+		KDI_Menu_types[number->type].print_value(menu, number->value, value);
+		return;
+	}
+
+	char buffer[KDI_FORMAT_BUFFER_SIZE];
+
+	KDI_Format_Fixed(buffer, value, number->decimals, menu->format_width);
+	menu->print_string(buffer);
+}
+
+/**
+  * @brief 		Print value of item
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param  	Functions of the type
+  * @param  	Pointer on the data of item
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Type_Print_None(KDI_Menu* menu, const KDI_Menu_Type* type, const void* data){
+
+	(void)type;
+
+	KDI_Menu_Type_Value_None(menu, data, 0);
+}
+
+static void KDI_Menu_Type_Print_String(KDI_Menu* menu, const KDI_Menu_Type* type, const void* data){
+
+	(void)type;
+
+	menu->print_string((char*)data);
+}
+
+static void KDI_Menu_Type_Print_Float(KDI_Menu* menu, const KDI_Menu_Type* type, const void* data){
+
+	(void)type;
+
+	/* Without print function of float convert it to string*/
+	if(menu->print_float){
+
+		menu->print_float(*(const float*)data);
+
+	}else{
+
+		char buffer[KDI_FORMAT_BUFFER_SIZE];
+
+		KDI_Format_Float(buffer, *(const float*)data, menu->format_decimals, menu->format_width);
+		menu->print_string(buffer);
+	}
+}
+
+static void KDI_Menu_Type_Print_Integer(KDI_Menu* menu, const KDI_Menu_Type* type, const void* data){
+
+	/* Read the variable and print it as value*/
+	type->print_value(menu, data, type->read(data));
+}
+
+static void KDI_Menu_Type_Print_Widget(KDI_Menu* menu, const KDI_Menu_Type* type, const void* data){
+
+	(void)menu; (void)type;
+
+	const KDI_Menu_Widget* widget = (const KDI_Menu_Widget*)data;
+
+	/* One call of the function of the widget*/
+	widget->render(widget->data);
+}
+
+/**
+ * @brief 		Data of items TYPE_DATA_IMAGE, see KDI_Menu_Type_Set_Image
+ */
+static const uint8_t* KDI_Menu_image_data = 0;
+
+static void* const* KDI_Menu_image_bindings = 0;
+
+static uint16_t KDI_Menu_image_binding_count = 0;
+
+/**
+  * @brief 		Find data and type of item TYPE_DATA_IMAGE
+  *
+  * @param  	Offset of KDI_Menu_Image_Data in the data of the image
+  * @param  	Pointer on pointer for functions of the type of the data
+  *	@return		Pointer on the data
+  */
+
+static const void* KDI_Menu_Type_Image_Find(const void* data, const KDI_Menu_Type** type){
+
+	const KDI_Menu_Image_Data* record = (const KDI_Menu_Image_Data*)(KDI_Menu_image_data + (uintptr_t)data);
+
+	/* String follows the record*/
+	if(record->type == TYPE_DATA_CHAR){
+
+		*type = &KDI_Menu_types[TYPE_DATA_CHAR];
+		return record + 1;
+	}
+
+	/* Wrong record is printed as "E0  "*/
+	if(record->type >= TYPE_DATA_IMAGE || record->binding >= KDI_Menu_image_binding_count){
+
+		*type = &KDI_Menu_types[TYPE_DATA_VOID];
+		return 0;
+	}
+
+	*type = &KDI_Menu_types[record->type];
+	return KDI_Menu_image_bindings[record->binding];
+}
+
+/**
+  * @brief 		Functions of items TYPE_DATA_IMAGE, they call functions of the type of the data
+  */
+
+static int32_t KDI_Menu_Type_Read_Image(const void* data){
+
+	const KDI_Menu_Type* type;
+	const void* found = KDI_Menu_Type_Image_Find(data, &type);
+
+	return type->read(found);
+}
+
+static void KDI_Menu_Type_Write_Image(const void* data, int32_t value){
+
+	const KDI_Menu_Type* type;
+	const void* found = KDI_Menu_Type_Image_Find(data, &type);
+
+	type->write(found, value);
+}
+
+static uint8_t KDI_Menu_Type_Edit_Image(const void* data, KDI_Menu_Edit* edit){
+
+	const KDI_Menu_Type* type;
+	const void* found = KDI_Menu_Type_Image_Find(data, &type);
+
+	return type->edit(found, edit);
+}
+
+static uint8_t KDI_Menu_Type_Update_Image(const KDI_Menu_Type* image, const void* data, KDI_Menu_Value* shown){
+
+	(void)image;
+
+	const KDI_Menu_Type* type;
+	const void* found = KDI_Menu_Type_Image_Find(data, &type);
+
+	return type->update(type, found, shown);
+}
+
+static void KDI_Menu_Type_Print_Image(KDI_Menu* menu, const KDI_Menu_Type* image, const void* data){
+
+	(void)image;
+
+	const KDI_Menu_Type* type;
+	const void* found = KDI_Menu_Type_Image_Find(data, &type);
+
+	type->print(menu, type, found);
+}
+
+static void KDI_Menu_Type_Value_Image(KDI_Menu* menu, const void* data, int32_t value){
+
+	const KDI_Menu_Type* type;
+	const void* found = KDI_Menu_Type_Image_Find(data, &type);
+
+	type->print_value(menu, found, value);
+}
+
+/**
+  * @brief 		Save data of items TYPE_DATA_IMAGE
+  *
+  * @param  	Pointer on data of the image, offsets of items are counted from it
+  * @param  	Table of pointers on variables and structures of items
+  * @param  	Number of pointers in the table
+  *	@return		Nope
+  *
+  * @note		Used by KDI_Menu_Image_Load, only one image is used at a time.
+  */
+
+void KDI_Menu_Type_Set_Image(const uint8_t* data, void* const* bindings, uint16_t count){
+
+	KDI_Menu_image_data = data;
+
+	KDI_Menu_image_bindings = bindings;
+
+	KDI_Menu_image_binding_count = count;
+}
+
+/**
+  * @brief 		Get string of item
+  * @param  	Pointer on KDI_Menu_item
+  *	@return		String of item TYPE_DATA_CHAR, also from image, or 0 for other types
+  */
+
+const char* KDI_Menu_Type_Label(const KDI_Menu_item* item){
+
+	if(item->type == TYPE_DATA_CHAR) return (const char*)item->data;
+
+	if(item->type != TYPE_DATA_IMAGE) return 0;
+
+	const KDI_Menu_Type* type;
+	const void* found = KDI_Menu_Type_Image_Find(item->data, &type);
+
+	return (type == &KDI_Menu_types[TYPE_DATA_CHAR]) ? (const char*)found : 0;
+}
+
+/**
+ * @brief 		Short names of functions for the table
+ */
+#define KDI_MENU_TYPE_INTEGER(name, value)	{KDI_Menu_Type_Read_##name, KDI_Menu_Type_Update_Integer, KDI_Menu_Type_Print_Integer,	\
+											 KDI_Menu_Type_Write_##name, KDI_Menu_Type_Edit_##name, KDI_Menu_Type_Value_##value}
+
+#define KDI_MENU_TYPE_OTHER(update, print)	{KDI_Menu_Type_Read_None, KDI_Menu_Type_Update_##update, KDI_Menu_Type_Print_##print,	\
+											 KDI_Menu_Type_Write_None, KDI_Menu_Type_Edit_None, KDI_Menu_Type_Value_None}
+
+/**
+ * @brief 		Table of functions, index is KDI_Type_data
+ */
+const KDI_Menu_Type KDI_Menu_types[KDI_MENU_TYPE_TABLE_SIZE] = {
+
+	/* TYPE_DATA_VOID*/		KDI_MENU_TYPE_OTHER(None, None),
+	/* TYPE_DATA_CHAR*/		KDI_MENU_TYPE_OTHER(String, String),
+	/* TYPE_DATA_INT*/		KDI_MENU_TYPE_INTEGER(Int, Integer),
+	/* TYPE_DATA_FLOAT*/	KDI_MENU_TYPE_OTHER(Float, Float),
+	/* TYPE_DATA_INT8*/		KDI_MENU_TYPE_INTEGER(Int8, Integer),
+	/* TYPE_DATA_UINT8*/	KDI_MENU_TYPE_INTEGER(Uint8, Integer),
+	/* TYPE_DATA_INT16*/	KDI_MENU_TYPE_INTEGER(Int16, Integer),
+	/* TYPE_DATA_UINT16*/	KDI_MENU_TYPE_INTEGER(Uint16, Integer),
+	/* TYPE_DATA_INT32*/	KDI_MENU_TYPE_INTEGER(Int32, Integer),
+	/* TYPE_DATA_UINT32*/	KDI_MENU_TYPE_INTEGER(Uint32, Uint32),
+	/* TYPE_DATA_BOOL*/		KDI_MENU_TYPE_INTEGER(Bool, Bool),
+	/* TYPE_DATA_ENUM*/		KDI_MENU_TYPE_INTEGER(Enum, Enum),
+	/* TYPE_DATA_FIXED*/	KDI_MENU_TYPE_INTEGER(Fixed, Fixed),
+	/* TYPE_DATA_WIDGET*/	KDI_MENU_TYPE_OTHER(Widget, Widget),
+	/* TYPE_DATA_NUMBER*/	KDI_MENU_TYPE_INTEGER(Number, Number),
+	/* TYPE_DATA_IMAGE*/	{KDI_Menu_Type_Read_Image, KDI_Menu_Type_Update_Image, KDI_Menu_Type_Print_Image,
+							 KDI_Menu_Type_Write_Image, KDI_Menu_Type_Edit_Image, KDI_Menu_Type_Value_Image},
+};
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,88 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Type.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of types of data of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for read and print data of items by the type of data (KDI_Type_data).
+ * For each type there are functions in the table KDI_Menu_types, the number of the type is the index in the table,
+ * so KDI_Menu_Handler calls the function of the type without checking the type.
+ * Variables are read in place through the pointer of the item, copies of variables are not needed.
+ * Functions write, edit and print_value are used by edit mode of KDI_Menu.
+ *
+ * The type of the data of KDI_Menu_Widget can not be TYPE_DATA_WIDGET or TYPE_DATA_IMAGE, such data would check
+ * the widget again without end, so it is checked as TYPE_DATA_VOID: the widget is printed only when the item is changed.
+ *
+ * 									##### How to add a new type #####
+ * 1) Add the type to KDI_Type_data, not more than 16 types because of 4 bit field of the item.
+ * 2) Write functions of the type in KDI_Menu_Type.c
+ * 	  or use functions of integer types if the variable is integer.
+ * 3) Add functions to KDI_Menu_types on the place of the type.
+ *
+ */
+
+#ifndef KDI_MENU_TYPE_H_
+#define KDI_MENU_TYPE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu.h
+ */
+#include "KDI_Menu.h"
+
+/*
+ * @brief	Number of places in the table, all values of 4 bit field of the item
+ */
+#define KDI_MENU_TYPE_TABLE_SIZE		16
+
+/*
+ * @brief	Strings of TYPE_DATA_BOOL
+ */
+#ifndef KDI_MENU_BOOL_ON
+#define KDI_MENU_BOOL_ON				"  ON"
+#endif
+
+#ifndef KDI_MENU_BOOL_OFF
+#define KDI_MENU_BOOL_OFF				" OFF"
+#endif
+
+/*
+ * @brief	Functions of one type of data
+ */
+
+typedef struct Menu_Type{
+
+	int32_t (*read)(const void* data);													/*!< Read integer value, 0 for not integer types */
+
+	uint8_t (*update)(const struct Menu_Type* type, const void* data, KDI_Menu_Value* shown);	/*!< Save value and return 1 if it changed */
+
+	void (*print)(KDI_Menu* menu, const struct Menu_Type* type, const void* data);		/*!< Print value */
+
+	void (*write)(const void* data, int32_t value);										/*!< Write integer value, nothing for not integer types */
+
+	uint8_t (*edit)(const void* data, KDI_Menu_Edit* edit);								/*!< Save limits of edit mode, 0 - value can not be edited */
+
+	void (*print_value)(KDI_Menu* menu, const void* data, int32_t value);				/*!< Print the value as the item, used for working copy */
+
+}KDI_Menu_Type;
+
+/*
+ * @brief	Table of functions, index is KDI_Type_data
+ */
+extern const KDI_Menu_Type KDI_Menu_types[KDI_MENU_TYPE_TABLE_SIZE];
+
+/*Function save data of items TYPE_DATA_IMAGE */
+void KDI_Menu_Type_Set_Image(const uint8_t* data, void* const* bindings, uint16_t count);
+
+/*Function get string of item */
+const char* KDI_Menu_Type_Label(const KDI_Menu_item* item);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_TYPE_H_ */
@@ -0,0 +1,431 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Bench.c
+ * @author  		Polzuchy_haos
+ * @brief   		Host benchmark of KDI_Menu module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This program is built and started on the computer (Linux), not on the microcontroller.
+ * It builds menus of different shapes and measures the time of building, of navigation commands
+ * and of the handler with empty print functions, and the memory used by the menu.
+ * The heap is measured after building, items are never freed while building, so this is the peak.
+ * With the item pool the heap is not used, the size of the pool is printed in the first line.
+ * Each result is printed as one line in JSON format, so results of different versions can be compared.
+ *
+ * 									##### How to use this program #####
+ * 1) Use "make run" in the folder of this file.
+ * 2) Use "make run POOL=65535 LINK=16" to measure the item pool with 16 bit links.
+ * 3) Use "make run PROF=1" to print also results of KDI_Menu_Prof for each shape, time in nanoseconds.
+ *
+ * The last results of each shape are the number of bytes sent by KDI_Menu_Term for the first frame
+ * and for each forward move, and the time of sorting and of one search of KDI_Menu_Search.
+ * Items have different names ("P0", "P1" ...), so a move which scrolls the window sends the changed lines.
+ * Then KDI_Menu_Step and KDI_Menu_Get_Position are measured on the largest ring before and after KDI_Menu_Pack.
+ *
+ * 	Shapes of menus:
+ * 		wide	-	one level of 2000 parameters with data.
+ * 		deep	-	7 levels, 2 items on each level, data on level 7.
+ * 		large	-	4 levels, 10 items on each level, 10000 parameters with data.
+ *
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "KDI_Menu.h"
+#include "KDI_Menu_Prof.h"
+#include "KDI_Menu_Term.h"
+#include "KDI_Menu_Search.h"
+
+#include <stdio.h>
+#include <time.h>
+#include <malloc.h>
+
+/**
+ * @brief 		Number of commands for measure of navigation
+ */
+#define KDI_BENCH_COMMANDS		1000000UL
+
+/**
+ * @brief 		Number of handler calls
+ */
+#define KDI_BENCH_HANDLER		1000000UL
+
+/**
+ * @brief 		Number of moves for measure of bytes sent to the terminal
+ */
+#define KDI_BENCH_TERM			10000UL
+
+/**
+ * @brief 		Number of searches
+ */
+#define KDI_BENCH_SEARCH		100000UL
+
+/**
+ * @brief 		Number of steps and positions for measure of the packed layout
+ */
+#define KDI_BENCH_PACKED		100000UL
+
+/**
+ * @brief 		Shape of the menu
+ */
+typedef struct{
+
+	const char* name;				/*!< Name of the shape */
+
+	unsigned int width;				/*!< Number of items on each level */
+
+	unsigned int depth;				/*!< Number of levels */
+
+}KDI_Bench_Shape;
+
+static const KDI_Bench_Shape KDI_Bench_Shapes[] = {
+
+	{"wide",	2000,	1},
+	{"deep",	2,		7},
+	{"large",	10,		4},
+};
+
+/**
+ * @brief 		Number of names of items, not less than the number of items of the largest shape
+ */
+#define KDI_BENCH_NAMES			32768U
+
+/**
+ * @brief 		Names of items "P0", "P1" ..., each item has its own name, so frames of the terminal differ,
+ * 				and data, the same for all items
+ */
+static char KDI_Bench_Names[KDI_BENCH_NAMES][8];
+
+static unsigned int KDI_Bench_Name_Count;
+
+static int KDI_Bench_Int = 1234;
+
+/**
+ * @brief 		Result of print functions, so they are not removed by the compiler
+ */
+static volatile int KDI_Bench_Sink;
+
+static void KDI_Bench_Print_String(char* string){ KDI_Bench_Sink += string[0]; }
+
+static void KDI_Bench_Print_Int(int value){ KDI_Bench_Sink += value; }
+
+static void KDI_Bench_Print_Float(float value){ KDI_Bench_Sink += (int)value; }
+
+static void KDI_Bench_Write(const char* data, uint16_t size){ KDI_Bench_Sink += data[0] + size; }
+
+/**
+  * @brief 		Get time in nanoseconds
+  * @param  	Nope
+  *	@return		Time in nanoseconds
+  */
+
+static unsigned long long KDI_Bench_Now(void){
+
+	struct timespec time;
+
+	clock_gettime(CLOCK_MONOTONIC, &time);
+
+	return (unsigned long long)time.tv_sec * 1000000000ULL + (unsigned long long)time.tv_nsec;
+}
+
+/**
+  * @brief 		Get size of used heap
+  * @param  	Nope
+  *	@return		Number of bytes
+  */
+
+static unsigned long long KDI_Bench_Heap(void){
+
+	struct mallinfo2 info = mallinfo2();
+
+	return info.uordblks;
+}
+
+/**
+  * @brief 		Get name of the next item
+  * @param  	Nope
+  *	@return		String "P" and number of the name
+  */
+
+static char* KDI_Bench_Name(void){
+
+	/* Names are used again if the menu is larger*/
+	char* name = KDI_Bench_Names[KDI_Bench_Name_Count % KDI_BENCH_NAMES];
+
+	snprintf(name, sizeof(KDI_Bench_Names[0]), "P%u", KDI_Bench_Name_Count % KDI_BENCH_NAMES);
+
+	KDI_Bench_Name_Count++;
+
+	return name;
+}
+
+/**
+  * @brief 		Build items below the current item
+  *
+  * @param  	Pointer on KDI_Menu, pointer is on the parent item
+  * @param		Number of items on each level
+  * @param		Number of levels below the current item
+  *	@return		MENU_STATUS_OK or MENU_STATUS_NO_MEMORY
+  */
+
+static KDI_Menu_Status KDI_Bench_Build_Level(KDI_Menu* menu, unsigned int width, unsigned int depth){
+
+	/* Last level, add data*/
+	if(!depth) return KDI_Menu_Add_Child(menu, &KDI_Bench_Int, TYPE_DATA_INT, MENU_END, MENU_COMMAND_NO);
+
+	/* First item of level*/
+	if(KDI_Menu_Add_Child(menu, KDI_Bench_Name(), TYPE_DATA_CHAR, MENU_NO_END, MENU_COMMAND_DOWN)) return MENU_STATUS_NO_MEMORY;
+
+	if(KDI_Bench_Build_Level(menu, width, depth - 1)) return MENU_STATUS_NO_MEMORY;
+
+	/* Other items of level*/
+	for(unsigned int i = 1; i < width; i++){
+
+		if(KDI_Menu_Add_Next(menu, KDI_Bench_Name(), TYPE_DATA_CHAR, MENU_COMMAND_FORWARD)) return MENU_STATUS_NO_MEMORY;
+
+		if(KDI_Bench_Build_Level(menu, width, depth - 1)) return MENU_STATUS_NO_MEMORY;
+	}
+
+	/* Return to parent*/
+	KDI_Menu_Drive(menu, MENU_COMMAND_UP);
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Build menu of the shape
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param		Pointer on shape
+  *	@return		MENU_STATUS_OK or MENU_STATUS_NO_MEMORY
+  */
+
+static KDI_Menu_Status KDI_Bench_Build(KDI_Menu* menu, const KDI_Bench_Shape* shape){
+
+	/* Names from the first one*/
+	KDI_Bench_Name_Count = 0;
+
+	/* First item of top level*/
+	if(KDI_Menu_Init(menu, KDI_Bench_Name(), TYPE_DATA_CHAR)) return MENU_STATUS_NO_MEMORY;
+
+	if(KDI_Bench_Build_Level(menu, shape->width, shape->depth - 1)) return MENU_STATUS_NO_MEMORY;
+
+	/* Other items of top level*/
+	for(unsigned int i = 1; i < shape->width; i++){
+
+		if(KDI_Menu_Add_Next(menu, KDI_Bench_Name(), TYPE_DATA_CHAR, MENU_COMMAND_FORWARD)) return MENU_STATUS_NO_MEMORY;
+
+		if(KDI_Bench_Build_Level(menu, shape->width, shape->depth - 1)) return MENU_STATUS_NO_MEMORY;
+	}
+
+	KDI_Menu_Start(menu);
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Measure one shape of menu
+  * @param  	Pointer on shape
+  *	@return		Nope
+  */
+
+static void KDI_Bench_Run(const KDI_Bench_Shape* shape){
+
+	KDI_Menu menu = {0};
+
+	/* Build*/
+	KDI_MenuItem_ResetPool();
+
+#if KDI_MENU_PROFILE
+	KDI_Menu_Prof_Init();
+#endif
+
+	unsigned long long heap = KDI_Bench_Heap();
+	unsigned long long start = KDI_Bench_Now();
+
+	if(KDI_Bench_Build(&menu, shape)){
+
+		printf("{\"bench\":\"build\",\"shape\":\"%s\",\"error\":\"no memory\"}\n", shape->name);
+		return;
+	}
+
+	unsigned long long time = KDI_Bench_Now() - start;
+	heap = KDI_Bench_Heap() - heap;
+
+	printf("{\"bench\":\"build\",\"shape\":\"%s\",\"items\":%u,\"ns\":%llu,\"ns_per_item\":%.1f,\"heap_bytes\":%llu}\n",
+			shape->name, menu.item_count, time, (double)time / menu.item_count, heap);
+
+	KDI_Menu_Set_print_char(&menu, KDI_Bench_Print_String);
+	KDI_Menu_Set_print_int(&menu, KDI_Bench_Print_Int);
+	KDI_Menu_Set_print_float(&menu, KDI_Bench_Print_Float);
+
+	/* Forward only*/
+	start = KDI_Bench_Now();
+
+	for(unsigned long i = 0; i < KDI_BENCH_COMMANDS; i++) KDI_Menu_Drive(&menu, MENU_COMMAND_FORWARD);
+
+	time = KDI_Bench_Now() - start;
+
+	printf("{\"bench\":\"forward\",\"shape\":\"%s\",\"items\":%u,\"ns_per_command\":%.2f}\n",
+			shape->name, menu.item_count, (double)time / KDI_BENCH_COMMANDS);
+
+	/* Random commands, the same sequence for all versions*/
+	unsigned long random = 1;
+
+	KDI_Menu_Start(&menu);
+
+	start = KDI_Bench_Now();
+
+	for(unsigned long i = 0; i < KDI_BENCH_COMMANDS; i++){
+
+		random = random * 1103515245UL + 12345UL;
+
+		KDI_Menu_Drive(&menu, (KDI_Menu_Command)(1 + ((random >> 16) & 3)));
+	}
+
+	time = KDI_Bench_Now() - start;
+
+	printf("{\"bench\":\"random\",\"shape\":\"%s\",\"items\":%u,\"ns_per_command\":%.2f}\n",
+			shape->name, menu.item_count, (double)time / KDI_BENCH_COMMANDS);
+
+	/* Handler, nothing changed*/
+	KDI_Menu_Start(&menu);
+
+	start = KDI_Bench_Now();
+
+	for(unsigned long i = 0; i < KDI_BENCH_HANDLER; i++) KDI_Menu_Handler(&menu);
+
+	time = KDI_Bench_Now() - start;
+
+	printf("{\"bench\":\"handler_idle\",\"shape\":\"%s\",\"items\":%u,\"ns_per_call\":%.2f}\n",
+			shape->name, menu.item_count, (double)time / KDI_BENCH_HANDLER);
+
+	/* Handler, print each time*/
+	start = KDI_Bench_Now();
+
+	for(unsigned long i = 0; i < KDI_BENCH_HANDLER; i++){
+
+		KDI_Menu_Redraw(&menu);
+		KDI_Menu_Handler(&menu);
+	}
+
+	time = KDI_Bench_Now() - start;
+
+	printf("{\"bench\":\"handler_redraw\",\"shape\":\"%s\",\"items\":%u,\"ns_per_call\":%.2f}\n",
+			shape->name, menu.item_count, (double)time / KDI_BENCH_HANDLER);
+
+#if KDI_MENU_PROFILE
+
+	/* Results of KDI_Menu_Prof*/
+	static const char* const names[MENU_PROF_COUNT] = {"handler", "forward", "backward", "up", "down"};
+
+	for(unsigned int i = 0; i < MENU_PROF_COUNT; i++){
+
+		KDI_Menu_Prof_stat stat;
+
+		KDI_Menu_Prof_Get((KDI_Menu_Prof_point)i, &stat);
+
+		printf("{\"bench\":\"prof\",\"shape\":\"%s\",\"function\":\"%s\",\"count\":%lu,\"min\":%lu,\"max\":%lu,\"mean\":%lu}\n",
+				shape->name, names[i], (unsigned long)stat.count, stat.count ? (unsigned long)stat.min : 0UL,
+				(unsigned long)stat.max, (unsigned long)KDI_Menu_Prof_Get_Mean((KDI_Menu_Prof_point)i));
+	}
+
+#endif
+
+	/* Terminal, bytes of the first frame and of each forward move*/
+	KDI_Menu_Term term;
+
+	KDI_Menu_Jump_Item(&menu, menu.Head);
+
+	KDI_Menu_Term_Init(&term, &menu, KDI_MENU_WINDOW_LINES, KDI_Bench_Write);
+
+	KDI_Menu_Term_Handler(&term);
+
+	unsigned long frame = term.sent;
+
+	for(unsigned long i = 0; i < KDI_BENCH_TERM; i++){
+
+		KDI_Menu_Drive(&menu, MENU_COMMAND_FORWARD);
+		KDI_Menu_Term_Handler(&term);
+	}
+
+	printf("{\"bench\":\"term\",\"shape\":\"%s\",\"items\":%u,\"frame_bytes\":%lu,\"bytes_per_move\":%.2f}\n",
+			shape->name, menu.item_count, frame, (double)(term.sent - frame) / KDI_BENCH_TERM);
+
+	/* Search index, sorting and search by the start of the string*/
+	KDI_Menu_item** table = malloc(menu.item_count * sizeof(KDI_Menu_item*));
+
+	if(!table) return;
+
+	KDI_Menu_Search search;
+
+	start = KDI_Bench_Now();
+
+	uint16_t count = KDI_Menu_Search_Init(&search, &menu, table, menu.item_count);
+
+	time = KDI_Bench_Now() - start;
+
+	unsigned long long find = KDI_Bench_Now();
+
+	for(unsigned long i = 0; i < KDI_BENCH_SEARCH; i++) KDI_Bench_Sink += KDI_Menu_Search_Find(&search, "P12", 0);
+
+	find = KDI_Bench_Now() - find;
+
+	printf("{\"bench\":\"search\",\"shape\":\"%s\",\"labels\":%u,\"init_ns\":%llu,\"ns_per_find\":%.2f}\n",
+			shape->name, count, time, (double)find / KDI_BENCH_SEARCH);
+
+	free(table);
+
+	/* Steps and positions in the ring of the head, before and after packing*/
+	KDI_Menu_item* array = malloc(menu.item_count * sizeof(KDI_Menu_item));
+
+	if(!array) return;
+
+	double ns[2][2];
+
+	for(unsigned int packed = 0; packed < 2; packed++){
+
+		if(packed && KDI_Menu_Pack(&menu, array, menu.item_count)) break;
+
+		KDI_Menu_Jump_Item(&menu, menu.Head);
+
+		start = KDI_Bench_Now();
+
+		for(unsigned long i = 0; i < KDI_BENCH_PACKED; i++) KDI_Menu_Step(&menu, 7);
+
+		ns[packed][0] = (double)(KDI_Bench_Now() - start) / KDI_BENCH_PACKED;
+
+		start = KDI_Bench_Now();
+
+		for(unsigned long i = 0; i < KDI_BENCH_PACKED; i++) KDI_Bench_Sink += KDI_Menu_Get_Position(&menu, 0);
+
+		ns[packed][1] = (double)(KDI_Bench_Now() - start) / KDI_BENCH_PACKED;
+	}
+
+	if(menu.packed){
+
+		printf("{\"bench\":\"packed\",\"shape\":\"%s\",\"items\":%u,\"ns_per_step\":%.2f,\"ns_per_step_packed\":%.2f,"
+				"\"ns_per_position\":%.2f,\"ns_per_position_packed\":%.2f}\n",
+				shape->name, menu.item_count, ns[0][0], ns[1][0], ns[0][1], ns[1][1]);
+	}
+
+	/* Links are indices in the pool again*/
+	KDI_MenuItem_SetArray(0);
+
+	free(array);
+}
+
+int main(void){
+
+	/* Settings of the build*/
+	printf("{\"bench\":\"config\",\"item_bytes\":%u,\"menu_bytes\":%u,\"pool_size\":%u,\"pool_bytes\":%lu,\"link_bits\":%u}\n",
+			(unsigned int)sizeof(KDI_Menu_item), (unsigned int)sizeof(KDI_Menu), (unsigned int)KDI_MENU_POOL_SIZE,
+			(unsigned long)(KDI_MENU_POOL_SIZE * sizeof(KDI_Menu_item)), (unsigned int)KDI_MENU_ITEM_LINK_BITS);
+
+	for(unsigned int i = 0; i < sizeof(KDI_Bench_Shapes) / sizeof(KDI_Bench_Shapes[0]); i++){
+
+		KDI_Bench_Run(&KDI_Bench_Shapes[i]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,296 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Cursor.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Cursor module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for show one menu to many users, see KDI_Menu_Cursor.h.
+ *
+ */
+
+#include "KDI_Menu_Cursor.h"
+
+/**
+ * @brief Includes for memcpy and offsetof
+ */
+#include <string.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief 		Init cursor on the first item of the menu
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param  	Pointer on built KDI_Menu
+  *	@return		Nope
+  *
+  * @note		Print functions are copied from the menu, change them by KDI_Menu_Cursor_Set_print_x.
+  */
+
+void KDI_Menu_Cursor_Init(KDI_Menu_Cursor* cursor, const KDI_Menu* menu){
+
+	/* Save common menu*/
+	cursor->menu = menu;
+
+	/* Start of the menu*/
+	cursor->pointer = KDI_MENU_ITEM_TO_LINK(menu->Head);
+
+	cursor->Command = MENU_COMMAND_NO;
+
+	/* Print functions of the menu*/
+	cursor->print_string = menu->print_string;
+
+	cursor->print_int = menu->print_int;
+
+	cursor->print_float = menu->print_float;
+
+	/* Nothing is displayed yet*/
+	cursor->shown_item = 0;
+
+	/* Edit mode is off*/
+	cursor->edit.item = 0;
+
+#if KDI_MENU_BREADCRUMB
+	/* No parents*/
+	cursor->depth = 0;
+#endif
+}
+
+/**
+  * @brief 		Make the menu of the cursor
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param  	Pointer on KDI_Menu for the copy, usually on the stack
+  *	@return		Nope
+  *
+  * @note		The copy is given to functions of KDI_Menu, then KDI_Menu_Cursor_Leave must be called.
+  */
+
+void KDI_Menu_Cursor_Enter(KDI_Menu_Cursor* cursor, KDI_Menu* view){
+
+#if KDI_MENU_BREADCRUMB
+	/* Common part, the stack of parents is the last field and is taken from the cursor*/
+	memcpy(view, cursor->menu, offsetof(KDI_Menu, depth));
+#else
+	/* Common part*/
+	*view = *cursor->menu;
+#endif
+
+	/* Part of the cursor*/
+	view->pointer = KDI_MENU_LINK_TO_ITEM(cursor->pointer);
+
+	view->level = KDI_MenuItem_GetLevel(view->pointer);
+
+	view->Command = (KDI_Menu_Command)cursor->Command;
+
+	view->print_string = cursor->print_string;
+
+	view->print_int = cursor->print_int;
+
+	view->print_float = cursor->print_float;
+
+	view->shown_item = KDI_MENU_LINK_TO_ITEM(cursor->shown_item);
+
+	view->shown_value = cursor->shown_value;
+
+	view->edit = cursor->edit;
+
+#if KDI_MENU_BREADCRUMB
+	/* Parents of the cursor*/
+	view->depth = cursor->depth;
+
+	for(uint8_t i = 0; i < cursor->depth; i++) view->path[i] = cursor->path[i];
+#endif
+}
+
+/**
+  * @brief 		Save state of the cursor from the menu made by KDI_Menu_Cursor_Enter
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param  	Pointer on KDI_Menu of KDI_Menu_Cursor_Enter
+  *	@return		Nope
+  */
+
+void KDI_Menu_Cursor_Leave(KDI_Menu_Cursor* cursor, const KDI_Menu* view){
+
+	cursor->pointer = KDI_MENU_ITEM_TO_LINK(view->pointer);
+
+	cursor->Command = (uint8_t)view->Command;
+
+	cursor->shown_item = KDI_MENU_ITEM_TO_LINK(view->shown_item);
+
+	cursor->shown_value = view->shown_value;
+
+	cursor->edit = view->edit;
+
+#if KDI_MENU_BREADCRUMB
+	cursor->depth = view->depth;
+
+	for(uint8_t i = 0; i < view->depth; i++) cursor->path[i] = view->path[i];
+#endif
+}
+
+/**
+  * @brief 		Move the cursor, see KDI_Menu_Drive
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param  	Menu navigation command
+  *	@return		Nope
+  */
+
+void KDI_Menu_Cursor_Drive(KDI_Menu_Cursor* cursor, KDI_Menu_Command command){
+
+	KDI_Menu view;
+
+	KDI_Menu_Cursor_Enter(cursor, &view);
+
+	KDI_Menu_Drive(&view, command);
+
+	KDI_Menu_Cursor_Leave(cursor, &view);
+}
+
+/**
+  * @brief 		Move the cursor by some steps, see KDI_Menu_Step
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param  	Number of steps, less than 0 - backward
+  *	@return		Nope
+  */
+
+void KDI_Menu_Cursor_Step(KDI_Menu_Cursor* cursor, int steps){
+
+	KDI_Menu view;
+
+	KDI_Menu_Cursor_Enter(cursor, &view);
+
+	KDI_Menu_Step(&view, steps);
+
+	KDI_Menu_Cursor_Leave(cursor, &view);
+}
+
+/**
+  * @brief 		Move the cursor to item by number, see KDI_Menu_Jump
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param  	Number of item
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND or MENU_STATUS_LEVEL_ERROR
+  */
+
+KDI_Menu_Status KDI_Menu_Cursor_Jump(KDI_Menu_Cursor* cursor, uint16_t id){
+
+	KDI_Menu view;
+
+	KDI_Menu_Cursor_Enter(cursor, &view);
+
+	KDI_Menu_Status status = KDI_Menu_Jump(&view, id);
+
+	KDI_Menu_Cursor_Leave(cursor, &view);
+
+	return status;
+}
+
+/**
+  * @brief 		Move the cursor to item by path, see KDI_Menu_Jump_Path
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param  	Path, names of items divided by '/'
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND or MENU_STATUS_LEVEL_ERROR
+  */
+
+KDI_Menu_Status KDI_Menu_Cursor_Jump_Path(KDI_Menu_Cursor* cursor, const char* path){
+
+	KDI_Menu view;
+
+	KDI_Menu_Cursor_Enter(cursor, &view);
+
+	KDI_Menu_Status status = KDI_Menu_Jump_Path(&view, path);
+
+	KDI_Menu_Cursor_Leave(cursor, &view);
+
+	return status;
+}
+
+/**
+  * @brief 		Display the item of the cursor by print functions of the cursor, see KDI_Menu_Handler
+  * @param  	Pointer on KDI_Menu_Cursor
+  *	@return		Nope
+  */
+
+void KDI_Menu_Cursor_Handler(KDI_Menu_Cursor* cursor){
+
+	KDI_Menu view;
+
+	KDI_Menu_Cursor_Enter(cursor, &view);
+
+	KDI_Menu_Handler(&view);
+
+	KDI_Menu_Cursor_Leave(cursor, &view);
+}
+
+/**
+  * @brief 		Print the item of the cursor again on the next handler call
+  * @param  	Pointer on KDI_Menu_Cursor
+  *	@return		Nope
+  */
+
+void KDI_Menu_Cursor_Redraw(KDI_Menu_Cursor* cursor){
+
+	/* Forget displayed item*/
+	cursor->shown_item = 0;
+}
+
+/**
+  * @brief 		Save pointer on function print string
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param		Pointer on function type "void name_fuction(char* p)"
+  * @return 	Nope
+  */
+
+void KDI_Menu_Cursor_Set_print_char(KDI_Menu_Cursor* cursor, void(*point)(char*)){
+
+	/* Save pointer on function*/
+	cursor->print_string = point;
+
+	KDI_Menu_Cursor_Redraw(cursor);
+}
+
+/**
+  * @brief 		Save pointer on function print int
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param		Pointer on function type "void name_fuction(int p)", 0 - numbers are printed as strings
+  * @return 	Nope
+  */
+
+void KDI_Menu_Cursor_Set_print_int(KDI_Menu_Cursor* cursor, void(*point)(int)){
+
+	/* Save pointer on function*/
+	cursor->print_int = point;
+
+	KDI_Menu_Cursor_Redraw(cursor);
+}
+
+/**
+  * @brief 		Save pointer on function print float
+  *
+  * @param  	Pointer on KDI_Menu_Cursor
+  * @param		Pointer on function type "void name_fuction(float p)", 0 - numbers are printed as strings
+  * @return 	Nope
+  */
+
+void KDI_Menu_Cursor_Set_print_float(KDI_Menu_Cursor* cursor, void(*point)(float)){
+
+	/* Save pointer on function*/
+	cursor->print_float = point;
+
+	KDI_Menu_Cursor_Redraw(cursor);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,120 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Cursor.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Cursor module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for show one menu to many users at the same time, for example sessions of a terminal.
+ * The menu is built once in KDI_Menu and is only read by cursors. A cursor keeps what is different
+ * for each user: current item, level, command, print functions, displayed value and edit mode.
+ * So each user needs only the structure KDI_Menu_Cursor instead of a copy of the whole menu.
+ *
+ * Functions of a cursor make a copy of KDI_Menu on the stack, put the state of the cursor into it,
+ * call the function of KDI_Menu and save the state back. The same is done by KDI_Menu_Cursor_Enter and
+ * KDI_Menu_Cursor_Leave for other functions with KDI_Menu, for example KDI_Menu_Term_Draw. Each call copies
+ * the common part of KDI_Menu (not the stack of parents of KDI_MENU_BREADCRUMB), so for several functions
+ * in a row call them between one KDI_Menu_Cursor_Enter and KDI_Menu_Cursor_Leave.
+ * Cursors do not write the menu, so cursors of one menu can be used in different threads. Values of items
+ * written by edit mode and the function commit of the menu (KDI_Menu_Set_Commit) are common for all cursors.
+ * The cursor keeps links on items, with KDI_MENU_ITEM_LINK_BITS they are 8 or 16 bit.
+ *
+ * 									##### How to use this driver #####
+ * 1) Build the menu as usual: KDI_Menu_Init, KDI_Menu_Add_Next, KDI_Menu_Add_Child ... or KDI_Menu_Init_Const.
+ * 2) For each user declare a structure KDI_Menu_Cursor and use functions:
+ *
+ * 		KDI_Menu_Cursor_Init(&Session, &MyMenu);
+ * 		KDI_Menu_Cursor_Set_print_char(&Session, session_print);
+ *
+ * 3) Move and display the menu of the user:
+ *
+ * 		KDI_Menu_Cursor_Drive(&Session, MENU_COMMAND_FORWARD);
+ * 		KDI_Menu_Cursor_Handler(&Session);
+ *
+ * 	  Other functions, for example a terminal of each user (KDI_Menu_Term_Init(&Session_term, &MyMenu, 4, write)):
+ *
+ * 		KDI_Menu view;
+ *
+ * 		KDI_Menu_Cursor_Enter(&Session, &view);
+ * 		KDI_Menu_Term_Draw(&Session_term, &view);
+ * 		KDI_Menu_Cursor_Leave(&Session, &view);
+ *
+ * 	  KDI_Menu_Window_Draw is used the same way. Terminals are drawn one at a time (see KDI_Menu_Term.h).
+ *
+ * Do not change the menu (KDI_Menu_Add_x, KDI_Menu_Destroy) while cursors are used.
+ *
+ */
+
+#ifndef KDI_MENU_CURSOR_H_
+#define KDI_MENU_CURSOR_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu.h
+ * 			Commands of cursors are executed by this library
+ *
+ */
+#include "KDI_Menu.h"
+
+/*
+ * @brief	State of one user of the menu
+ */
+
+typedef struct Menu_Cursor{
+
+	const KDI_Menu* menu;			/*!< Common menu, only read */
+
+	KDI_Menu_link pointer;			/*!< Link on current item of the user, the level of the user is the level of the item */
+
+	KDI_Menu_link shown_item;		/*!< Link on item displayed by the last handler call */
+
+	void(*print_string)(char* );	/*!< Pointer on function print string or char*/
+
+	void(*print_int)(int );			/*!< Pointer on function print int, 0 - numbers are printed as strings */
+
+	void(*print_float)(float );		/*!< Pointer of function print float, 0 - numbers are printed as strings */
+
+	KDI_Menu_Value shown_value;		/*!< Copy of the value displayed by the last handler call */
+
+	KDI_Menu_Edit edit;				/*!< State of edit mode */
+
+	uint8_t Command;				/*!< Command for handler, KDI_Menu_Command */
+
+#if KDI_MENU_BREADCRUMB
+
+	uint8_t depth;					/*!< Number of parents of the current item */
+
+	KDI_Menu_link path[KDI_MENU_BREADCRUMB_DEPTH];	/*!< Links on parents of the current item of the user */
+
+#endif
+
+}KDI_Menu_Cursor;
+
+/*Initialization function */
+void KDI_Menu_Cursor_Init(KDI_Menu_Cursor* cursor, const KDI_Menu* menu);
+
+/*Functions for use functions of KDI_Menu */
+void KDI_Menu_Cursor_Enter(KDI_Menu_Cursor* cursor, KDI_Menu* view);
+void KDI_Menu_Cursor_Leave(KDI_Menu_Cursor* cursor, const KDI_Menu* view);
+
+/*Functions of moving and displaying */
+void KDI_Menu_Cursor_Drive(KDI_Menu_Cursor* cursor, KDI_Menu_Command command);
+void KDI_Menu_Cursor_Step(KDI_Menu_Cursor* cursor, int steps);
+KDI_Menu_Status KDI_Menu_Cursor_Jump(KDI_Menu_Cursor* cursor, uint16_t id);
+KDI_Menu_Status KDI_Menu_Cursor_Jump_Path(KDI_Menu_Cursor* cursor, const char* path);
+void KDI_Menu_Cursor_Handler(KDI_Menu_Cursor* cursor);
+void KDI_Menu_Cursor_Redraw(KDI_Menu_Cursor* cursor);
+
+/*Functions set print functions */
+void KDI_Menu_Cursor_Set_print_char(KDI_Menu_Cursor* cursor, void(*point)(char*));
+void KDI_Menu_Cursor_Set_print_int(KDI_Menu_Cursor* cursor, void(*point)(int));
+void KDI_Menu_Cursor_Set_print_float(KDI_Menu_Cursor* cursor, void(*point)(float));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_CURSOR_H_ */
@@ -0,0 +1,213 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Frame.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Frame module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for send output of KDI_Menu by one transfer, see KDI_Menu_Frame.h.
+ *
+ * 	States of a buffer:
+ * 		free			-	the next frame is printed into it from the start;
+ * 		pending			-	the frame is printed, new output is added to its end;
+ * 		sending			-	the frame is given to the function flush, the buffer is not touched
+ * 							until KDI_Menu_Frame_Done.
+ *
+ * Only the interrupt writes "sending" to KDI_MENU_FRAME_NONE, only the main loop writes other values,
+ * so locks are not needed.
+ *
+ */
+
+#include "KDI_Menu_Frame.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Frame printed by the current handler call
+ */
+static KDI_Menu_Frame* KDI_Menu_Frame_current = 0;
+
+/**
+  * @brief 		Print function of the menu, adds string to the buffer
+  * @param  	String
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Frame_Print(char* string){
+
+	KDI_Menu_Frame* frame = KDI_Menu_Frame_current;
+
+	/* Not inside KDI_Menu_Frame_Begin and KDI_Menu_Frame_End*/
+	if(!frame || frame->current == KDI_MENU_FRAME_NONE) return;
+
+	char* buffer = frame->buffer[frame->current];
+
+	uint16_t* length = &frame->length[frame->current];
+
+	while(*string){
+
+		if(*length == frame->size){
+
+			frame->overflow = 1;
+			return;
+		}
+
+		buffer[(*length)++] = *string++;
+	}
+}
+
+/**
+  * @brief 		Initialization frame output
+  *
+  * @param  	Pointer on KDI_Menu_Frame
+  * @param  	Pointer on KDI_Menu
+  * @param  	First buffer
+  * @param  	Second buffer, 0 - only one buffer
+  * @param  	Size of each buffer
+  * @param		Pointer on function type "void name_fuction(const char* data, uint16_t size)", it starts the transfer
+  *	@return		Nope
+  *
+  * @note		Print functions of the menu are changed.
+  */
+
+void KDI_Menu_Frame_Init(KDI_Menu_Frame* frame, KDI_Menu* menu, char* buffer1, char* buffer2, uint16_t size,
+							void(*flush)(const char*, uint16_t)){
+
+	frame->menu = menu;
+
+	/* Save buffers*/
+	frame->buffer[0] = buffer1;
+
+	frame->buffer[1] = buffer2;
+
+	frame->size = size;
+
+	frame->length[0] = 0;
+
+	frame->length[1] = 0;
+
+	/* No transfer*/
+	frame->sending = KDI_MENU_FRAME_NONE;
+
+	frame->pending = KDI_MENU_FRAME_NONE;
+
+	frame->current = KDI_MENU_FRAME_NONE;
+
+	frame->overflow = 0;
+
+	/* Save pointer on function*/
+	frame->flush = flush;
+
+	/* Strings go to the buffer, numbers are converted to strings*/
+	KDI_Menu_Set_print_char(menu, KDI_Menu_Frame_Print);
+
+	KDI_Menu_Set_print_int(menu, 0);
+
+	KDI_Menu_Set_print_float(menu, 0);
+}
+
+/**
+  * @brief 		Start printing of a frame
+  * @param  	Pointer on KDI_Menu_Frame
+  *	@return		1 - print the frame, 0 - no free buffer, do not print now
+  *
+  * @note		Call KDI_Menu_Frame_End after it in both cases.
+  */
+
+uint8_t KDI_Menu_Frame_Begin(KDI_Menu_Frame* frame){
+
+	uint8_t sending = frame->sending;
+
+	KDI_Menu_Frame_current = frame;
+
+	/* Add output to the waiting frame*/
+	if(frame->pending != KDI_MENU_FRAME_NONE){
+
+		frame->current = frame->pending;
+		return 1;
+	}
+
+	/* Buffer which is not sent*/
+	if(sending != 0){
+
+		frame->current = 0;
+
+	}else if(frame->buffer[1]){
+
+		frame->current = 1;
+
+	}else{
+
+		/* One buffer, it is sent now*/
+		frame->current = KDI_MENU_FRAME_NONE;
+		return 0;
+	}
+
+	/* New frame*/
+	frame->length[frame->current] = 0;
+
+	return 1;
+}
+
+/**
+  * @brief 		End printing of a frame and start the transfer if the bus is free
+  * @param  	Pointer on KDI_Menu_Frame
+  *	@return		Nope
+  *
+  * @note		Nothing is sent if nothing was printed.
+  */
+
+void KDI_Menu_Frame_End(KDI_Menu_Frame* frame){
+
+	/* Printed frame waits for transfer*/
+	if(frame->current != KDI_MENU_FRAME_NONE && frame->length[frame->current]) frame->pending = frame->current;
+
+	frame->current = KDI_MENU_FRAME_NONE;
+
+	/* Start transfer of the waiting frame*/
+	if(frame->pending != KDI_MENU_FRAME_NONE && frame->sending == KDI_MENU_FRAME_NONE){
+
+		uint8_t number = frame->pending;
+
+		frame->pending = KDI_MENU_FRAME_NONE;
+
+		frame->sending = number;
+
+		frame->flush(frame->buffer[number], frame->length[number]);
+	}
+}
+
+/**
+  * @brief 		Displays menu by one transfer, see KDI_Menu_Handler
+  * @param  	Pointer on KDI_Menu_Frame
+  *	@return		Nope
+  *
+  * @note		Call it in the main loop, it also sends the frame which waited for the end of the last transfer.
+  */
+
+void KDI_Menu_Frame_Handler(KDI_Menu_Frame* frame){
+
+	if(KDI_Menu_Frame_Begin(frame)) KDI_Menu_Handler(frame->menu);
+
+	KDI_Menu_Frame_End(frame);
+}
+
+/**
+  * @brief 		End of the transfer
+  * @param  	Pointer on KDI_Menu_Frame
+  *	@return		Nope
+  *
+  * @note		Call it in the interrupt of the end of DMA transfer, or after the function flush for blocking output.
+  */
+
+void KDI_Menu_Frame_Done(KDI_Menu_Frame* frame){
+
+	/* Buffer is free*/
+	frame->sending = KDI_MENU_FRAME_NONE;
+}
+
+#ifdef __cplusplus
+}
+#endif
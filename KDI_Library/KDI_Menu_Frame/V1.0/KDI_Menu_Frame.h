@@ -0,0 +1,102 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Frame.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Frame module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for send output of KDI_Menu by one transfer, for example DMA to SPI display or UART.
+ * Strings printed by the handler are collected in a buffer of the program, then the function flush
+ * is called once with the buffer and its length. The function starts the transfer and returns at once,
+ * the interrupt of the end of the transfer calls KDI_Menu_Frame_Done.
+ *
+ * With two buffers the next frame is printed into the second buffer while the first one is sent.
+ * If the transfer is not ended yet, the frame waits and is sent by the next handler call after
+ * KDI_Menu_Frame_Done, new output is added to the waiting frame. With one buffer the handler
+ * is skipped while the buffer is sent, the menu is printed on a later call.
+ *
+ * Numbers are printed as strings by KDI_Format, the print functions of the menu are changed.
+ *
+ * 									##### How to use this driver #####
+ * 1) Create menu KDI_Menu.
+ * 2) Write function which starts the transfer:
+ *
+ * 		void oled_dma_start(const char* data, uint16_t size);
+ *
+ * 3) Declare a structure KDI_Menu_Frame, buffers, and use function KDI_Menu_Frame_Init:
+ *
+ * 		char Frame_buffer[2][64];
+ *
+ * 		KDI_Menu_Frame_Init(&MyFrame, &MyMenu, Frame_buffer[0], Frame_buffer[1], 64, oled_dma_start);
+ *
+ * 4) In the interrupt of the end of the transfer call KDI_Menu_Frame_Done(&MyFrame).
+ * 5) Call KDI_Menu_Frame_Handler instead of KDI_Menu_Handler. For other output, for example KDI_Menu_Window:
+ *
+ * 		if(KDI_Menu_Frame_Begin(&MyFrame)) KDI_Menu_Window_Handler(&MyWindow);
+ *
+ * 		KDI_Menu_Frame_End(&MyFrame);
+ *
+ */
+
+#ifndef KDI_MENU_FRAME_H_
+#define KDI_MENU_FRAME_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu.h
+ * 			Frames are printed by this library
+ *
+ */
+#include "KDI_Menu.h"
+
+/*
+ * @brief	Number of buffer, no buffer
+ */
+#define KDI_MENU_FRAME_NONE		0xFF
+
+/*
+ * @brief	Structure of the frame output
+ */
+
+typedef struct Menu_Frame{
+
+	KDI_Menu* menu;							/*!< Printed menu */
+
+	char* buffer[2];						/*!< Buffers of the program, the second is 0 for one buffer */
+
+	uint16_t size;							/*!< Size of each buffer */
+
+	uint16_t length[2];						/*!< Number of bytes in each buffer */
+
+	volatile uint8_t sending;				/*!< Number of the buffer in transfer, KDI_MENU_FRAME_NONE - no transfer */
+
+	uint8_t pending;						/*!< Number of the buffer waiting for transfer, KDI_MENU_FRAME_NONE - no one */
+
+	uint8_t current;						/*!< Number of the buffer for printing */
+
+	uint8_t overflow;						/*!< 1 - some bytes did not fit in the buffer since the last init */
+
+	void(*flush)(const char*, uint16_t);	/*!< Pointer on function start the transfer */
+
+}KDI_Menu_Frame;
+
+/*Initialization function */
+void KDI_Menu_Frame_Init(KDI_Menu_Frame* frame, KDI_Menu* menu, char* buffer1, char* buffer2, uint16_t size,
+							void(*flush)(const char*, uint16_t));
+
+/*Handler functions */
+void KDI_Menu_Frame_Handler(KDI_Menu_Frame* frame);
+uint8_t KDI_Menu_Frame_Begin(KDI_Menu_Frame* frame);
+void KDI_Menu_Frame_End(KDI_Menu_Frame* frame);
+
+/*Function for the interrupt of the end of the transfer */
+void KDI_Menu_Frame_Done(KDI_Menu_Frame* frame);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_FRAME_H_ */
@@ -0,0 +1,450 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Image.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Image module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for save a whole menu as one binary image and start the menu from the image at once.
+ * Loading checks the header, then each item once: links must be inside the array, rings must be
+ * linked in both directions, children must link back on the parent and be one level deeper,
+ * records with strings must be inside the data part. After that the array of items is given to KDI_Menu_Init_Const
+ * and the data part to the functions of TYPE_DATA_IMAGE (see KDI_Menu_Type.c).
+ *
+ * Writing passes the items three times in order of numbers: size of data, items, data.
+ * Nothing is allocated, the image is given to the write function in small parts.
+ *
+ */
+
+#include "KDI_Menu_Image.h"
+
+/**
+ * @brief Includes table of functions of types of data
+ */
+#include "KDI_Menu_Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Includes for strlen and memset
+ */
+#include <string.h>
+
+#if KDI_MENU_ITEM_LINK_BITS
+
+/**
+ * @brief 		Size of record of data rounded up to 4 bytes
+ */
+#define KDI_MENU_IMAGE_ALIGN(size)		(((size) + 3UL) & ~3UL)
+
+/**
+  * @brief 		Check link of item of the image
+  *
+  * @param  	Link
+  * @param  	Number of items
+  * @param  	1 - link must be, links of the ring, 0 - KDI_MENU_NO_LINK is allowed
+  *	@return		1 if the link is inside the array of items
+  */
+
+static uint8_t KDI_Menu_Image_Check_Link(KDI_Menu_link link, uint32_t count, uint8_t required){
+
+	if(required && link == KDI_MENU_NO_LINK) return 0;
+
+	return (uint32_t)link <= count;
+}
+
+/**
+  * @brief 		Check links of item with other items of the image
+  *
+  * @param  	Array of items
+  * @param  	Number of the item
+  *	@return		1 if the rings and the tree are right
+  *
+  * @note		Links of the item must be checked by KDI_Menu_Image_Check_Link before.
+  * 			Items of a ring have one level and one parent, children have the next level or the data level,
+  * 			items of the data level have no children, so the tree has no loops.
+  */
+
+static uint8_t KDI_Menu_Image_Check_Tree(const KDI_Menu_item* items, uint32_t number){
+
+	const KDI_Menu_item* item = &items[number];
+
+	const KDI_Menu_item* next = &items[item->next_item - 1];
+
+	/* Ring is linked in both directions*/
+	if(next->last_item != (KDI_Menu_link)(number + 1) || next->level_menu != item->level_menu) return 0;
+
+#if !KDI_MENU_BREADCRUMB
+	/* All items of the ring link on the parent of the ring*/
+	if(next->parent_item != item->parent_item) return 0;
+#endif
+
+	if(item->child_item == KDI_MENU_NO_LINK) return 1;
+
+	/* Data has no children*/
+	if(item->level_menu == MENU_LEVEL_DATA) return 0;
+
+	const KDI_Menu_item* child = &items[item->child_item - 1];
+
+	if(child->level_menu != MENU_LEVEL_DATA && child->level_menu != item->level_menu + 1) return 0;
+
+#if !KDI_MENU_BREADCRUMB
+	/* Child links back on its parent*/
+	if(child->parent_item != (KDI_Menu_link)(number + 1)) return 0;
+#endif
+
+	return 1;
+}
+
+/**
+  * @brief 		Check record of item of the image
+  *
+  * @param  	Pointer on data part
+  * @param  	Size of data part
+  * @param  	Offset of the record
+  *	@return		1 if the record and its string are inside the data part
+  */
+
+static uint8_t KDI_Menu_Image_Check_Data(const uint8_t* data, uint32_t size, uintptr_t offset){
+
+	/* Record is inside data and aligned*/
+	if(offset % 4 || offset + sizeof(KDI_Menu_Image_Data) > size) return 0;
+
+	const KDI_Menu_Image_Data* record = (const KDI_Menu_Image_Data*)(data + offset);
+
+	if(record->type != TYPE_DATA_CHAR) return 1;
+
+	/* String must end inside data*/
+	for(uintptr_t i = offset + sizeof(KDI_Menu_Image_Data); i < size; i++){
+
+		if(!data[i]) return 1;
+	}
+
+	return 0;
+}
+
+#endif
+
+/**
+  * @brief 		Start menu from the image
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param  	Pointer on the image, aligned as pointer
+  * @param  	Size of the image
+  * @param  	Table of pointers on variables and structures of items
+  * @param  	Number of pointers in the table
+  *	@return		MENU_STATUS_OK or MENU_STATUS_IMAGE_ERROR if the image is wrong or made by other build
+  *
+  * @note		The image and the table are used while the menu is used, they must not be freed.
+  */
+
+KDI_Menu_Status KDI_Menu_Image_Load(KDI_Menu* menu, const void* image, uint32_t size, void* const* bindings, uint16_t count){
+
+#if KDI_MENU_ITEM_LINK_BITS
+
+	const KDI_Menu_Image_Header* header = (const KDI_Menu_Image_Header*)image;
+
+	/* Check header*/
+	if((uintptr_t)image % sizeof(void*) || size < sizeof(KDI_Menu_Image_Header)) return MENU_STATUS_IMAGE_ERROR;
+
+	if(header->magic != KDI_MENU_IMAGE_MAGIC || header->version != KDI_MENU_IMAGE_VERSION) return MENU_STATUS_IMAGE_ERROR;
+
+	if(header->link_bits != KDI_MENU_ITEM_LINK_BITS || header->item_size != sizeof(KDI_Menu_item)) return MENU_STATUS_IMAGE_ERROR;
+
+	if(header->flags != KDI_MENU_IMAGE_FLAGS) return MENU_STATUS_IMAGE_ERROR;
+
+	if(!header->item_count || header->item_count >= (1UL << KDI_MENU_ITEM_LINK_BITS)) return MENU_STATUS_IMAGE_ERROR;
+
+	/* Check parts*/
+	if(header->size > size || header->items % sizeof(void*)) return MENU_STATUS_IMAGE_ERROR;
+
+	if(header->items > header->size || header->item_count > (header->size - header->items) / sizeof(KDI_Menu_item)) return MENU_STATUS_IMAGE_ERROR;
+
+	if(header->data > header->size || header->data_size > header->size - header->data) return MENU_STATUS_IMAGE_ERROR;
+
+	/* Records are aligned from the start of the data part, data is after items*/
+	if(header->data % 4 || header->data < header->items + header->item_count * sizeof(KDI_Menu_item)) return MENU_STATUS_IMAGE_ERROR;
+
+	const KDI_Menu_item* items = (const KDI_Menu_item*)((const uint8_t*)image + header->items);
+
+	const uint8_t* data = (const uint8_t*)image + header->data;
+
+#if !KDI_MENU_BREADCRUMB
+	/* Ring of the head is on the top*/
+	if(items[0].parent_item != KDI_MENU_NO_LINK) return MENU_STATUS_IMAGE_ERROR;
+#endif
+
+	/* Check items*/
+	for(uint32_t i = 0; i < header->item_count; i++){
+
+		const KDI_Menu_item* item = &items[i];
+
+		if(!KDI_Menu_Image_Check_Link(item->next_item, header->item_count, 1)) return MENU_STATUS_IMAGE_ERROR;
+		if(!KDI_Menu_Image_Check_Link(item->last_item, header->item_count, 1)) return MENU_STATUS_IMAGE_ERROR;
+#if !KDI_MENU_BREADCRUMB
+		if(!KDI_Menu_Image_Check_Link(item->parent_item, header->item_count, 0)) return MENU_STATUS_IMAGE_ERROR;
+#endif
+		if(!KDI_Menu_Image_Check_Link(item->child_item, header->item_count, 0)) return MENU_STATUS_IMAGE_ERROR;
+
+		/* Rings and children*/
+		if(!KDI_Menu_Image_Check_Tree(items, i)) return MENU_STATUS_IMAGE_ERROR;
+
+		/* Only items with record or without data*/
+		if(item->type == TYPE_DATA_VOID) continue;
+
+		if(item->type != TYPE_DATA_IMAGE || !KDI_Menu_Image_Check_Data(data, header->data_size, (uintptr_t)item->data)) return MENU_STATUS_IMAGE_ERROR;
+	}
+
+	/* Data of items*/
+	KDI_Menu_Type_Set_Image(data, bindings, count);
+
+	/* Items are used in place, the first item is the head*/
+	KDI_Menu_Init_Const(menu, items);
+
+	return MENU_STATUS_OK;
+
+#else
+
+	(void)menu; (void)image; (void)size; (void)bindings; (void)count;
+
+	/* Pointer links can not be saved*/
+	return MENU_STATUS_IMAGE_ERROR;
+
+#endif
+}
+
+#if KDI_MENU_ITEM_LINK_BITS
+
+/**
+  * @brief 		Find record of item
+  *
+  * @param  	Pointer on KDI_Menu_item
+  * @param  	Table of pointers on variables and structures of items
+  * @param  	Number of pointers in the table
+  * @param  	Pointer on record for result
+  * @param  	Pointer on string for result, 0 - item without string
+  *	@return		Size of the record with string, 0 if the data of item is not in the table
+  */
+
+static uint32_t KDI_Menu_Image_Record(const KDI_Menu_item* item, void* const* bindings, uint16_t count,
+										KDI_Menu_Image_Data* record, const char** label){
+
+	record->reserved = 0;
+
+	record->binding = 0;
+
+	/* String is saved in the image*/
+	*label = KDI_Menu_Type_Label(item);
+
+	if(*label){
+
+		record->type = TYPE_DATA_CHAR;
+		return KDI_MENU_IMAGE_ALIGN(sizeof(KDI_Menu_Image_Data) + strlen(*label) + 1);
+	}
+
+	record->type = item->type;
+
+	/* Pointer is saved as number in the table*/
+	for(uint16_t i = 0; i < count; i++){
+
+		if(bindings[i] == item->data){
+
+			record->binding = i;
+			return sizeof(KDI_Menu_Image_Data);
+		}
+	}
+
+	return 0;
+}
+
+/**
+  * @brief 		Get link of the image
+  *
+  * @param  	Pointer on linked item, 0 - no link
+  * @param  	Number of items in the image
+  *	@return		Number of the item + 1, 0 - no link, or count + 1 if the item is not in the image
+  */
+
+static KDI_Menu_link KDI_Menu_Image_Link(const KDI_Menu_item* item, uint32_t count){
+
+	if(!item) return KDI_MENU_NO_LINK;
+
+	if(KDI_MenuItem_GetId((KDI_Menu_item*)item) >= count) return (KDI_Menu_link)(count + 1);
+
+	return (KDI_Menu_link)(KDI_MenuItem_GetId((KDI_Menu_item*)item) + 1);
+}
+
+#endif
+
+/**
+  * @brief 		Write the image of the menu
+  *
+  * @param  	Pointer on KDI_Menu
+  * @param  	Table of pointers on variables and structures of items
+  * @param  	Number of pointers in the table
+  * @param		Pointer on function type "void name_fuction(const void* data, uint32_t size)",
+  * 			it writes the next part of the image, for example to a file
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND if the table of items by number is not set,
+  * 			an item is not in it or data of an item is not in the table of bindings,
+  * 			MENU_STATUS_IMAGE_ERROR with pointer links
+  *
+  * @note		Items are numbered by KDI_Menu_Set_Id_Table, the head must have number 0,
+  * 			numbers without item are saved as empty items linked only on themselves.
+  * 			Nothing is written if the status is not MENU_STATUS_OK.
+  */
+
+KDI_Menu_Status KDI_Menu_Image_Write(KDI_Menu* menu, void* const* bindings, uint16_t count, void(*write)(const void*, uint32_t)){
+
+#if KDI_MENU_ITEM_LINK_BITS
+
+	KDI_Menu_item** table = menu->id_table;
+
+	uint32_t item_count = menu->id_table_size;
+
+	if(!table || !item_count || item_count >= (1UL << KDI_MENU_ITEM_LINK_BITS)) return MENU_STATUS_NOT_FOUND;
+
+	/* Loading starts from the first item*/
+	if(table[0] != menu->Head) return MENU_STATUS_NOT_FOUND;
+
+	KDI_Menu_Image_Data record;
+
+	const char* label;
+
+	/* Size of data, check items*/
+	uint32_t data_size = 0;
+
+	for(uint32_t i = 0; i < item_count; i++){
+
+		KDI_Menu_item* item = table[i];
+
+		if(!item) continue;
+
+		/* Linked items must be in the table*/
+		if(KDI_Menu_Image_Link(KDI_MENU_ITEM_NEXT(item), item_count) > item_count) return MENU_STATUS_NOT_FOUND;
+		if(KDI_Menu_Image_Link(KDI_MENU_ITEM_LAST(item), item_count) > item_count) return MENU_STATUS_NOT_FOUND;
+#if !KDI_MENU_BREADCRUMB
+		if(KDI_Menu_Image_Link(KDI_MENU_ITEM_PARENT(item), item_count) > item_count) return MENU_STATUS_NOT_FOUND;
+#endif
+		if(KDI_Menu_Image_Link(KDI_MENU_ITEM_CHILD(item), item_count) > item_count) return MENU_STATUS_NOT_FOUND;
+
+		if(item->type == TYPE_DATA_VOID) continue;
+
+		uint32_t record_size = KDI_Menu_Image_Record(item, bindings, count, &record, &label);
+
+		if(!record_size) return MENU_STATUS_NOT_FOUND;
+
+		data_size += record_size;
+	}
+
+	/* Header*/
+	KDI_Menu_Image_Header header;
+
+	memset(&header, 0, sizeof(header));
+
+	header.magic = KDI_MENU_IMAGE_MAGIC;
+
+	header.version = KDI_MENU_IMAGE_VERSION;
+
+	header.link_bits = KDI_MENU_ITEM_LINK_BITS;
+
+	header.item_size = sizeof(KDI_Menu_item);
+
+	header.flags = KDI_MENU_IMAGE_FLAGS;
+
+	header.item_count = item_count;
+
+	header.items = sizeof(KDI_Menu_Image_Header);
+
+	header.data = header.items + item_count * sizeof(KDI_Menu_item);
+
+	header.data_size = data_size;
+
+	header.size = header.data + data_size;
+
+	write(&header, sizeof(header));
+
+	/* Items, links are numbers of items*/
+	uint32_t offset = 0;
+
+	for(uint32_t i = 0; i < item_count; i++){
+
+		KDI_Menu_item* item = table[i];
+
+		KDI_Menu_item copy;
+
+		/* Padding bytes are 0, so the same menu gives the same image*/
+		memset(&copy, 0, sizeof(copy));
+
+		copy.id = (uint16_t)i;
+
+		copy.type = TYPE_DATA_VOID;
+
+		/* Empty item is a ring of one item, so loading checks all items the same way*/
+		copy.next_item = (KDI_Menu_link)(i + 1);
+		copy.last_item = (KDI_Menu_link)(i + 1);
+
+		if(item){
+
+			copy.level_menu = item->level_menu;
+
+			copy.next_item = KDI_Menu_Image_Link(KDI_MENU_ITEM_NEXT(item), item_count);
+			copy.last_item = KDI_Menu_Image_Link(KDI_MENU_ITEM_LAST(item), item_count);
+#if !KDI_MENU_BREADCRUMB
+			copy.parent_item = KDI_Menu_Image_Link(KDI_MENU_ITEM_PARENT(item), item_count);
+#endif
+			copy.child_item = KDI_Menu_Image_Link(KDI_MENU_ITEM_CHILD(item), item_count);
+
+			/* Data is the offset of the record*/
+			if(item->type != TYPE_DATA_VOID){
+
+				copy.type = TYPE_DATA_IMAGE;
+
+				copy.data = (void*)(uintptr_t)offset;
+
+				offset += KDI_Menu_Image_Record(item, bindings, count, &record, &label);
+			}
+		}
+
+		write(&copy, sizeof(copy));
+	}
+
+	/* Records and strings*/
+	for(uint32_t i = 0; i < item_count; i++){
+
+		KDI_Menu_item* item = table[i];
+
+		if(!item || item->type == TYPE_DATA_VOID) continue;
+
+		uint32_t record_size = KDI_Menu_Image_Record(item, bindings, count, &record, &label);
+
+		write(&record, sizeof(record));
+
+		if(!label) continue;
+
+		uint32_t length = (uint32_t)strlen(label) + 1;
+
+		write(label, length);
+
+		/* Zeros up to 4 bytes*/
+		static const uint8_t zeros[4] = {0, 0, 0, 0};
+
+		write(zeros, record_size - sizeof(record) - length);
+	}
+
+	return MENU_STATUS_OK;
+
+#else
+
+	(void)menu; (void)bindings; (void)count; (void)write;
+
+	/* Pointer links can not be saved*/
+	return MENU_STATUS_IMAGE_ERROR;
+
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
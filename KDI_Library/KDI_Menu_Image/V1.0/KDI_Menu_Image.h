@@ -0,0 +1,119 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Image.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Image module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for save a whole menu as one binary image and start the menu from the image at once.
+ * The image is used in place: from flash of the microcontroller or from a file mapped by mmap on the computer,
+ * nothing is copied and memory is not allocated. Loading checks the image and the links in one pass,
+ * so a damaged image is not started: each ring is closed in both directions, all its items have one parent
+ * and the tree has no loops.
+ * The host test KDI_Menu_Test_Image writes and loads a large menu and compares the paths and items of both menus.
+ *
+ * 	Image:
+ * 		KDI_Menu_Image_Header	-	size and offsets of parts;
+ * 		items					-	array of KDI_Menu_item with index links, item number N has id N;
+ * 		data					-	KDI_Menu_Image_Data of each item, strings follow their records.
+ *
+ * Items of the image have type TYPE_DATA_IMAGE, their data is the offset of the record in the data part.
+ * Strings are inside the image. Variables and structures (KDI_Menu_Enum ...) of other items are
+ * pointers of the table of bindings, the image saves only the number of the pointer in the table.
+ *
+ * The image is made by KDI_Menu_Image_Write from a menu built by functions KDI_Menu_Add_x.
+ * Items and pointers are saved as they are in memory, so the image is read only by a program
+ * with the same KDI_MENU_ITEM_LINK_BITS, size of pointer and byte order, this is checked by loading.
+ * Links are indices, so KDI_MENU_ITEM_LINK_BITS must be 8 or 16, with pointer links the functions return an error.
+ *
+ * 									##### How to use this driver #####
+ * 1) Make the table of bindings, the same for writing and loading:
+ *
+ * 		void* const Bindings[2] = {&Speed, (void*)&Mode_item};
+ *
+ * 2) Write the image of a built menu, KDI_Menu_Set_Id_Table must be called before:
+ *
+ * 		void file_write(const void* data, uint32_t size);
+ *
+ * 		KDI_Menu_Image_Write(&MyMenu, Bindings, 2, file_write);
+ *
+ * 3) Start the menu from the image instead of building it:
+ *
+ * 		KDI_Menu_Image_Load(&MyMenu, image, image_size, Bindings, 2);
+ *
+ * 	  To reload the image call KDI_Menu_Image_Load again with the new image.
+ *
+ */
+
+#ifndef KDI_MENU_IMAGE_H_
+#define KDI_MENU_IMAGE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu.h
+ */
+#include "KDI_Menu.h"
+
+/*
+ * @brief	First 4 bytes of the image, "KDIM"
+ */
+#define KDI_MENU_IMAGE_MAGIC		0x4D49444BUL
+
+/*
+ * @brief	Version of the format of the image
+ */
+#define KDI_MENU_IMAGE_VERSION		1
+
+/*
+ * @brief	Flags of the layout of items in the image
+ */
+#define KDI_MENU_IMAGE_FLAG_BREADCRUMB	0x01UL		/*!< Items have no link on parent, KDI_MENU_BREADCRUMB */
+
+#if KDI_MENU_BREADCRUMB
+#define KDI_MENU_IMAGE_FLAGS		KDI_MENU_IMAGE_FLAG_BREADCRUMB
+#else
+#define KDI_MENU_IMAGE_FLAGS		0UL
+#endif
+
+/*
+ * @brief	Header of the image, offsets are counted from the start of the image
+ */
+
+typedef struct{
+
+	uint32_t magic;					/*!< KDI_MENU_IMAGE_MAGIC */
+
+	uint16_t version;				/*!< KDI_MENU_IMAGE_VERSION */
+
+	uint8_t link_bits;				/*!< KDI_MENU_ITEM_LINK_BITS of the writer */
+
+	uint8_t item_size;				/*!< sizeof(KDI_Menu_item) of the writer */
+
+	uint32_t item_count;			/*!< Number of items */
+
+	uint32_t items;					/*!< Offset of the array of items */
+
+	uint32_t data;					/*!< Offset of the data part */
+
+	uint32_t data_size;				/*!< Size of the data part */
+
+	uint32_t size;					/*!< Size of the whole image */
+
+	uint32_t flags;					/*!< KDI_MENU_IMAGE_FLAGS of the writer, 0 in images of older versions */
+
+}KDI_Menu_Image_Header;
+
+/*Function start menu from the image */
+KDI_Menu_Status KDI_Menu_Image_Load(KDI_Menu* menu, const void* image, uint32_t size, void* const* bindings, uint16_t count);
+
+/*Function write the image of the menu */
+KDI_Menu_Status KDI_Menu_Image_Write(KDI_Menu* menu, void* const* bindings, uint16_t count, void(*write)(const void*, uint32_t));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_IMAGE_H_ */
@@ -70,23 +70,95 @@
 extern "C" {
 #endif
 
+#if KDI_MENU_POOL_SIZE == 0
+
 /**
  * @brief 		Includes for used malloc
  */
 #include <stdlib.h>
 
+#else
+
+/**
+ * @brief 		Static pool of menu items
+ */
+static KDI_Menu_item KDI_Menu_item_pool[KDI_MENU_POOL_SIZE];
+
+/**
+ * @brief 		List of returned menu items, linked through data
+ */
+static KDI_Menu_item* KDI_Menu_item_free_list = 0;
+
+/**
+ * @brief 		Number of pool items that were never given out
+ */
+static unsigned int KDI_Menu_item_pool_used = 0;
+
+/**
+ * @brief 		Number of free menu items in the pool
+ */
+static unsigned int KDI_Menu_item_pool_free = KDI_MENU_POOL_SIZE;
+
+#endif
+
+#if KDI_MENU_ITEM_LINK_BITS
+
+/**
+ * @brief 		Array of menu items for index links
+ */
+KDI_Menu_item* KDI_Menu_item_array = KDI_Menu_item_pool;
+
+#endif
+
+/**
+ * @brief 		Status of the pool since the last reset
+ */
+static KDI_Pool_status KDI_Menu_item_pool_status = ITEM_POOL_OK;
+
 /**
  * @brief		Get new menu item
  * @param 		Nope
  *
- * @return		Pointer KDI_Menu_item*
+ * @return		Pointer KDI_Menu_item*, 0 if there is no free memory
  */
 
 KDI_Menu_item* KDI_GetMenu_item(){
 
+#if KDI_MENU_POOL_SIZE == 0
+
 	/* Allocation of dynamic memory for structure*/
 	KDI_Menu_item* item = malloc(sizeof(KDI_Menu_item));
 
+#else
+
+	KDI_Menu_item* item = 0;
+
+	/* Take item from list of returned items*/
+	if(KDI_Menu_item_free_list){
+
+		item = KDI_Menu_item_free_list;
+
+		KDI_Menu_item_free_list = (KDI_Menu_item*)item->data;
+
+	/* Take item that was never given out*/
+	}else if(KDI_Menu_item_pool_used < KDI_MENU_POOL_SIZE){
+
+		item = &KDI_Menu_item_pool[KDI_Menu_item_pool_used++];
+	}
+
+	/* Count free items*/
+	if(item) KDI_Menu_item_pool_free--;
+
+#endif
+
+	/* Check memory*/
+	if(!item){
+
+		/* Save status of the pool*/
+		KDI_Menu_item_pool_status = ITEM_POOL_EMPTY;
+		return 0;
+	}
+
 	/* Initialize the entire structure with zeros*/
 	item->child_item = 0;
 
@@ -96,17 +168,137 @@ KDI_Menu_item* KDI_GetMenu_item(){
 
 	item->next_item = 0;
 
+#if !KDI_MENU_BREADCRUMB
 	item->parent_item = 0;
+#endif
 
 	item->type = 0;
 
 	item->level_menu = 0;
 
+	item->id = 0;
+
 	/* Return pointer on new menu item*/
 	return item;
 
 }
 
+/**
+ * @brief		Return menu item in the pool
+ * @param 		Pointer on menu item type KDI_Menu_item*
+ *
+ * @return		Nope
+ *
+ * @note		Links of other items on this item are not changed.
+ */
+
+void KDI_FreeMenu_item(KDI_Menu_item* item){
+
+	/* Check pointer*/
+	if(!item) return;
+
+#if KDI_MENU_POOL_SIZE == 0
+
+	/* Free dynamic memory*/
+	free(item);
+
+#else
+
+	/* Put item at the top of list of returned items*/
+	item->data = KDI_Menu_item_free_list;
+
+	KDI_Menu_item_free_list = item;
+
+	/* Count free items*/
+	KDI_Menu_item_pool_free++;
+
+#endif
+}
+
+/**
+ * @brief		Return all menu items in the pool
+ * @param 		Nope
+ *
+ * @return		Nope
+ *
+ * @note		All items taken before become invalid.
+ * 				With KDI_MENU_POOL_SIZE == 0 only the status is reset.
+ */
+
+void KDI_MenuItem_ResetPool(void){
+
+#if KDI_MENU_POOL_SIZE > 0
+
+	/* Forget returned items and start from the first pool item*/
+	KDI_Menu_item_free_list = 0;
+
+	KDI_Menu_item_pool_used = 0;
+
+	KDI_Menu_item_pool_free = KDI_MENU_POOL_SIZE;
+
+#endif
+
+	/* Reset status of the pool*/
+	KDI_Menu_item_pool_status = ITEM_POOL_OK;
+}
+
+/**
+ * @brief		Set array of menu items for index links
+ * @param 		Pointer on first item of the array, 0 - the item pool
+ *
+ * @return		Nope
+ *
+ * @note		Used only with KDI_MENU_ITEM_LINK_BITS 8 or 16, items are never written through it.
+ */
+
+void KDI_MenuItem_SetArray(const KDI_Menu_item* array){
+
+#if KDI_MENU_ITEM_LINK_BITS
+
+	/* Save pointer on array*/
+	KDI_Menu_item_array = array ? (KDI_Menu_item*)array : KDI_Menu_item_pool;
+
+#else
+
+	(void)array;
+
+#endif
+}
+
+/**
+ * @brief		Get status of the pool
+ * @param 		Nope
+ *
+ * @return		ITEM_POOL_EMPTY if some KDI_GetMenu_item call failed since the last reset
+ */
+
+KDI_Pool_status KDI_MenuItem_GetPoolStatus(void){
+
+	/* Return status of the pool*/
+	return KDI_Menu_item_pool_status;
+}
+
+/**
+ * @brief		Get number of free menu items in the pool
+ * @param 		Nope
+ *
+ * @return		Number of free items, 0 if KDI_MENU_POOL_SIZE == 0
+ */
+
+unsigned int KDI_MenuItem_GetPoolFree(void){
+
+#if KDI_MENU_POOL_SIZE > 0
+
+	/* Return number of free items*/
+	return KDI_Menu_item_pool_free;
+
+#else
+
+	return 0;
+
+#endif
+}
+
 /**
  * @brief		Save pointer on data
  * @param 		Pointer on menu item type KDI_Menu_item*
@@ -161,7 +353,7 @@ void KDI_MenuItem_SetTypeData(KDI_Menu_item* item, KDI_Type_data type){
 KDI_Type_data KDI_MenuItem_GetTypeData(KDI_Menu_item* item){
 
 	/* Return pointer on data saved inside menu item*/
-	return item->type;
+	return (KDI_Type_data)item->type;
 
 }
 
@@ -189,7 +381,35 @@ void KDI_MenuItem_SetLevel(KDI_Menu_item* item, KDI_Menu_Level level){
 KDI_Menu_Level KDI_MenuItem_GetLevel(KDI_Menu_item* item){
 
 	/* Return menu level saved inside menu item*/
-	return item->level_menu;
+	return (KDI_Menu_Level)item->level_menu;
+
+}
+
+/**
+ * @brief		Save number of menu item
+ * @param 		Pointer on menu item type KDI_Menu_item*
+ * @param		Number of item
+ *
+ * @return		Nope
+ */
+void KDI_MenuItem_SetId(KDI_Menu_item* item, uint16_t id){
+
+	/* Set number of item*/
+	item->id = id;
+
+}
+
+/**
+ * @brief		Get number of menu item
+ * @param 		Pointer on menu item type KDI_Menu_item*
+ *
+ * @return		Number of item
+ */
+
+uint16_t KDI_MenuItem_GetId(KDI_Menu_item* item){
+
+	/* Return number of item saved inside menu item*/
+	return item->id;
 
 }
 
@@ -203,7 +423,7 @@ KDI_Menu_Level KDI_MenuItem_GetLevel(KDI_Menu_item* item){
 void KDI_MenuItem_SetLinkOnNextMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2){
 
 	/* Save pointer on next menu item*/
-	item1->next_item = item2;
+	item1->next_item = KDI_MENU_ITEM_TO_LINK(item2);
 }
 
 /**
@@ -215,9 +435,11 @@ void KDI_MenuItem_SetLinkOnNextMenuItem(KDI_Menu_item* item1, KDI_Menu_item* ite
 void KDI_MenuItem_SetLinkOnLastMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2){
 
 	/* Save pointer on last menu item*/
-	item1->last_item = item2;
+	item1->last_item = KDI_MENU_ITEM_TO_LINK(item2);
 }
 
+#if !KDI_MENU_BREADCRUMB
+
 /**
  * @brief		Set pointer on parent menu level
  * @param 		Pointer on menu item type KDI_Menu_item*
@@ -227,9 +449,11 @@ void KDI_MenuItem_SetLinkOnLastMenuItem(KDI_Menu_item* item1, KDI_Menu_item* ite
 void KDI_MenuItem_SetLinkOnParentMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2){
 
 	/* Save pointer on parent menu item*/
-	item1->parent_item = item2;
+	item1->parent_item = KDI_MENU_ITEM_TO_LINK(item2);
 }
 
+#endif
+
 /**
  * @brief		Set pointer on child menu level
  * @param 		Pointer on menu item type KDI_Menu_item*
@@ -239,7 +463,7 @@ void KDI_MenuItem_SetLinkOnParentMenuItem(KDI_Menu_item* item1, KDI_Menu_item* i
 void KDI_MenuItem_SetLinkOnChildMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2){
 
 	/* Save pointer on child menu item*/
-	item1->child_item = item2;
+	item1->child_item = KDI_MENU_ITEM_TO_LINK(item2);
 }
 
 /**
@@ -251,7 +475,7 @@ void KDI_MenuItem_SetLinkOnChildMenuItem(KDI_Menu_item* item1, KDI_Menu_item* it
 KDI_Menu_item* KDI_MenuItem_GetLinkOnNextMenuItem(KDI_Menu_item* item1){
 
 	/* Return pointer on next menu item*/
-	return item1->next_item;
+	return KDI_MENU_ITEM_NEXT(item1);
 }
 
 /**
@@ -263,9 +487,11 @@ KDI_Menu_item* KDI_MenuItem_GetLinkOnNextMenuItem(KDI_Menu_item* item1){
 KDI_Menu_item* KDI_MenuItem_GetLinkOnLastMenuItem(KDI_Menu_item* item1){
 
 	/* Return pointer on last menu item*/
-	return item1->last_item;
+	return KDI_MENU_ITEM_LAST(item1);
 }
 
+#if !KDI_MENU_BREADCRUMB
+
 /**
  * @brief		Get pointer on parent menu level
  * @param 		Pointer on menu item type KDI_Menu_item*
@@ -275,9 +501,11 @@ KDI_Menu_item* KDI_MenuItem_GetLinkOnLastMenuItem(KDI_Menu_item* item1){
 KDI_Menu_item* KDI_MenuItem_GetLinkOnParentMenuItem(KDI_Menu_item* item1){
 
 	/* Return pointer on parant menu item*/
-	return item1->parent_item;
+	return KDI_MENU_ITEM_PARENT(item1);
 }
 
+#endif
+
 /**
  * @brief		Get pointer on child menu level
  * @param 		Pointer on menu item type KDI_Menu_item*
@@ -287,7 +515,109 @@ KDI_Menu_item* KDI_MenuItem_GetLinkOnParentMenuItem(KDI_Menu_item* item1){
 KDI_Menu_item* KDI_MenuItem_GetLinkOnChildMenuItem(KDI_Menu_item* item1){
 
 	/* Return pointer on child menu item*/
-	return item1->child_item;
+	return KDI_MENU_ITEM_CHILD(item1);
+}
+
+#if !KDI_MENU_BREADCRUMB
+
+/**
+ * @brief		Get next item of the tree in depth-first order
+ * @param 		Pointer on current menu item type KDI_Menu_item*
+ * @param 		Pointer on first item of the top level type KDI_Menu_item*
+ *
+ * @return		KDI_Menu_item* menu item, 0 after the last item of the tree
+ *
+ * @note		Recursion and memory are not used, the walk goes only through links.
+ */
+KDI_Menu_item* KDI_MenuItem_GetNextInTree(KDI_Menu_item* item, KDI_Menu_item* head){
+
+	/* Go down if the item has a child*/
+	if(item->child_item) return KDI_MENU_ITEM_CHILD(item);
+
+	/* Go forward, or up if it is the last item of a ring*/
+	while(item){
+
+		/* First item of the current ring*/
+		KDI_Menu_item* first = item->parent_item ? KDI_MENU_ITEM_CHILD(KDI_MENU_ITEM_PARENT(item)) : head;
+
+		/* Next item not yet visited*/
+		if(item->next_item && KDI_MENU_ITEM_NEXT(item) != first) return KDI_MENU_ITEM_NEXT(item);
+
+		/* Return to parent*/
+		item = KDI_MENU_ITEM_PARENT(item);
+	}
+
+	/* End of the tree*/
+	return 0;
+}
+
+#endif
+
+/**
+ * @brief		Start walk of the tree in depth-first order
+ * @param 		Pointer on KDI_Menu_Walk
+ * @param 		Pointer on first item of the top level type KDI_Menu_item*
+ *
+ * @return		KDI_Menu_item* first item, 0 if the tree is empty
+ *
+ * @note		Parents are kept in the structure, so the walk does not need links on parents.
+ * 				Children below MENU_LEVEL_MAX parents are skipped.
+ */
+KDI_Menu_item* KDI_MenuItem_Walk_Start(KDI_Menu_Walk* walk, KDI_Menu_item* head){
+
+	walk->head = head;
+
+	walk->item = head;
+
+	walk->depth = 0;
+
+	return head;
+}
+
+/**
+ * @brief		Get next item of the walk
+ * @param 		Pointer on KDI_Menu_Walk
+ *
+ * @return		KDI_Menu_item* menu item, 0 after the last item of the tree
+ *
+ * @note		After the call walk->parents[0 ... depth - 1] are the parents of the returned item.
+ */
+KDI_Menu_item* KDI_MenuItem_Walk_Next(KDI_Menu_Walk* walk){
+
+	KDI_Menu_item* item = walk->item;
+
+	if(!item) return 0;
+
+	/* Go down if the item has a child*/
+	if(item->child_item && walk->depth < MENU_LEVEL_MAX){
+
+		walk->parents[walk->depth++] = item;
+
+		walk->item = KDI_MENU_ITEM_CHILD(item);
+
+		return walk->item;
+	}
+
+	/* Go forward, or up if it is the last item of a ring*/
+	while(item){
+
+		/* First item of the current ring*/
+		KDI_Menu_item* first = walk->depth ? KDI_MENU_ITEM_CHILD(walk->parents[walk->depth - 1]) : walk->head;
+
+		/* Next item not yet visited*/
+		if(item->next_item && KDI_MENU_ITEM_NEXT(item) != first){
+
+			item = KDI_MENU_ITEM_NEXT(item);
+			break;
+		}
+
+		/* Return to parent*/
+		item = walk->depth ? walk->parents[--walk->depth] : 0;
+	}
+
+	walk->item = item;
+
+	return item;
 }
 
 #ifdef __cplusplus
@@ -18,6 +18,62 @@
  * 5) Create a pointer and a handler for your tasks and point to the first menu item,
  * 	  after which, after the events appear in the handler, follow the pointers inside
  *
+ * 												##### Memory for menu items #####
+ * Menu items are taken from a static pool of KDI_MENU_POOL_SIZE items, malloc is not used.
+ * Define KDI_MENU_POOL_SIZE in the project settings for the size of your menu.
+ * Define KDI_MENU_POOL_SIZE as 0 to take menu items from the heap.
+ * If the pool is empty KDI_GetMenu_item return 0 and KDI_MenuItem_GetPoolStatus return ITEM_POOL_EMPTY.
+ *
+ * 												##### Constant menu in ROM #####
+ * The whole menu can be declared as a constant array of items, such array is placed in flash
+ * and does not use the pool. Links are addresses of the array items or 0, use KDI_MENU_ITEM_CONST:
+ *
+ * 		static const KDI_Menu_item Menu[3] = {
+ *
+ * 			KDI_MENU_ITEM_CONST("   A", TYPE_DATA_CHAR, MENU_LEVEL_1, &Menu[1], &Menu[1], 0, &Menu[2]),
+ * 			KDI_MENU_ITEM_CONST("   B", TYPE_DATA_CHAR, MENU_LEVEL_1, &Menu[0], &Menu[0], 0, 0),
+ * 			KDI_MENU_ITEM_CONST(&A,     TYPE_DATA_INT,  MENU_LEVEL_DATA, &Menu[2], &Menu[2], &Menu[0], 0),
+ * 		};
+ *
+ * In C++ the same macro calls constexpr function KDI_MenuItem_Const, the size of the array must be given.
+ * Items of such menu must never be changed, use them only for reading.
+ * Use KDI_MENU_ITEM_CONST_ID with the number of the item as first parameter to jump to items by number.
+ * Write links as KDI_MENU_LINK(Menu, 1) and KDI_MENU_NO_LINK, then the table is valid for any link layout.
+ *
+ * 												##### Types of data #####
+ * Data of an item is a pointer on a variable, the variable is read in place by the type of the item:
+ * string, int, float, int8_t ... uint32_t and bool. For TYPE_DATA_ENUM the data is a pointer on KDI_Menu_Enum,
+ * for TYPE_DATA_FIXED on KDI_Menu_Fixed, these structures hold the pointer on the variable and how to print it:
+ *
+ * 		static const char* const Mode_labels[3] = {" OFF", "AUTO", " MAN"};
+ * 		static const KDI_Menu_Enum Mode_item = {&Mode, TYPE_DATA_UINT8, 3, Mode_labels};
+ *
+ * 		static const KDI_Menu_Fixed Temp_item = {&Temp, TYPE_DATA_INT16, 1};		Temp 215 is printed as "21.5"
+ *
+ * For own displays (bar graph, icons) use TYPE_DATA_WIDGET, the data is a pointer on KDI_Menu_Widget
+ * with the function that prints the item. It is called when the item or its data changed:
+ *
+ * 		void Level_bar(const void* data);
+ * 		static const KDI_Menu_Widget Level_item = {Level_bar, &Level, TYPE_DATA_UINT8};
+ *
+ * Values of integer, bool, enum, fixed-point and number items can be changed in edit mode of KDI_Menu.
+ * For limits other than the range of the type use TYPE_DATA_NUMBER:
+ *
+ * 		static const KDI_Menu_Number Speed_item = {&Speed, TYPE_DATA_UINT16, 0, 0, 3000, 10};
+ *
+ * 												##### Link layout #####
+ * By default links between menu items are pointers. Define KDI_MENU_ITEM_LINK_BITS as 8 or 16 to store links
+ * as 8 or 16 bit indices in one array of items, this makes a menu item several times smaller.
+ * The array is the item pool, so KDI_MENU_POOL_SIZE must be less than 256 or 65536,
+ * or the constant menu started by KDI_Menu_Init_Const, then its first item must be the first item of the array.
+ * Only one array of items is used at a time. Use macros KDI_MENU_ITEM_NEXT, KDI_MENU_ITEM_LAST,
+ * KDI_MENU_ITEM_PARENT and KDI_MENU_ITEM_CHILD or functions to follow links, they work for any layout.
+ *
+ * Define KDI_MENU_BREADCRUMB as 1 to remove the link on parent from items. Then KDI_Menu keeps the parents
+ * of the current item in a stack (breadcrumbs) filled while going down, and the tree is walked by KDI_Menu_Walk
+ * which keeps its own stack. Constant menus keep the parameter of the parent in KDI_MENU_ITEM_CONST, it is not saved.
+ * KDI_MENU_ITEM_PARENT and functions of the parent link do not exist in this mode.
+ *
  *
  *
  *
@@ -32,6 +88,50 @@
 extern "C" {
 #endif
 
+/*
+ * @brief Includes for fixed size integer types
+ */
+#include <stdint.h>
+
+/*
+ * @brief Number of menu items in the static pool, 0 - menu items are taken from the heap
+ */
+#ifndef KDI_MENU_POOL_SIZE
+#define KDI_MENU_POOL_SIZE		64
+#endif
+
+/*
+ * @brief Size of the link between menu items: 0 - pointer, 8 or 16 - index in the array of items
+ */
+#ifndef KDI_MENU_ITEM_LINK_BITS
+#define KDI_MENU_ITEM_LINK_BITS	0
+#endif
+
+/*
+ * @brief 1 - items have no link on parent, parents are kept in the stack of the menu
+ */
+#ifndef KDI_MENU_BREADCRUMB
+#define KDI_MENU_BREADCRUMB		0
+#endif
+
+#if KDI_MENU_ITEM_LINK_BITS == 8
+typedef uint8_t KDI_Menu_link;
+#elif KDI_MENU_ITEM_LINK_BITS == 16
+typedef uint16_t KDI_Menu_link;
+#elif KDI_MENU_ITEM_LINK_BITS == 0
+typedef struct Menu_item* KDI_Menu_link;
+#else
+#error "KDI_MENU_ITEM_LINK_BITS must be 0, 8 or 16"
+#endif
+
+#if KDI_MENU_ITEM_LINK_BITS && (KDI_MENU_POOL_SIZE == 0)
+#error "KDI_MENU_ITEM_LINK_BITS needs the item pool, KDI_MENU_POOL_SIZE must not be 0"
+#endif
+
+#if KDI_MENU_ITEM_LINK_BITS && (KDI_MENU_POOL_SIZE >= (1UL << KDI_MENU_ITEM_LINK_BITS))
+#error "KDI_MENU_POOL_SIZE is too big for KDI_MENU_ITEM_LINK_BITS"
+#endif
+
 /*
  * @brief This enum used for save type pointer on a data
  */
@@ -41,9 +141,107 @@ typedef enum{
 	TYPE_DATA_CHAR		=	1,
 	TYPE_DATA_INT		=	2,
 	TYPE_DATA_FLOAT		=	3,
+	TYPE_DATA_INT8		=	4,
+	TYPE_DATA_UINT8		=	5,
+	TYPE_DATA_INT16		=	6,
+	TYPE_DATA_UINT16	=	7,
+	TYPE_DATA_INT32		=	8,
+	TYPE_DATA_UINT32	=	9,
+	TYPE_DATA_BOOL		=	10,		/*!< Data is bool */
+	TYPE_DATA_ENUM		=	11,		/*!< Data is KDI_Menu_Enum */
+	TYPE_DATA_FIXED		=	12,		/*!< Data is KDI_Menu_Fixed */
+	TYPE_DATA_WIDGET	=	13,		/*!< Data is KDI_Menu_Widget */
+	TYPE_DATA_NUMBER	=	14,		/*!< Data is KDI_Menu_Number */
+	TYPE_DATA_IMAGE		=	15,		/*!< Data is offset of KDI_Menu_Image_Data in the loaded image */
 
 }KDI_Type_data;
 
+/*
+ * @brief Number of types, the type of item is saved in 4 bits
+ */
+#define TYPE_DATA_COUNT		16
+
+/*
+ * @brief Data of item TYPE_DATA_ENUM, the value is printed as a label from the table
+ */
+
+typedef struct{
+
+	const void* value;				/*!< Pointer on the variable */
+
+	KDI_Type_data type;				/*!< Type of the variable, one of the integer types */
+
+	uint8_t count;					/*!< Number of labels */
+
+	const char* const* labels;		/*!< Table of labels, the value is the number of the label */
+
+}KDI_Menu_Enum;
+
+/*
+ * @brief Data of item TYPE_DATA_FIXED, the value is printed with a decimal point, for example 1234 as "12.34"
+ */
+
+typedef struct{
+
+	const void* value;				/*!< Pointer on the variable */
+
+	KDI_Type_data type;				/*!< Type of the variable, one of the integer types */
+
+	uint8_t decimals;				/*!< Number of decimal places */
+
+}KDI_Menu_Fixed;
+
+/*
+ * @brief Data of item TYPE_DATA_WIDGET, the item is printed by its own function
+ */
+
+typedef struct{
+
+	void (*render)(const void* data);	/*!< Pointer on function print the item, the data is passed to it */
+
+	const void* data;					/*!< Pointer on data of the widget */
+
+	KDI_Type_data type;					/*!< Type of the data, used to check changes, TYPE_DATA_VOID - only when the item is changed,
+											 TYPE_DATA_WIDGET and TYPE_DATA_IMAGE are checked as TYPE_DATA_VOID */
+
+}KDI_Menu_Widget;
+
+/*
+ * @brief Data of item TYPE_DATA_NUMBER, integer or fixed-point value with limits for edit mode
+ */
+
+typedef struct{
+
+	void* value;					/*!< Pointer on the variable */
+
+	KDI_Type_data type;				/*!< Type of the variable, one of the integer types */
+
+	uint8_t decimals;				/*!< Number of decimal places, 0 - integer */
+
+	int32_t min;					/*!< Minimum value */
+
+	int32_t max;					/*!< Maximum value */
+
+	int32_t step;					/*!< Change of the value by one command */
+
+}KDI_Menu_Number;
+
+/*
+ * @brief Data of item TYPE_DATA_IMAGE inside a binary image of menu, see KDI_Menu_Image.h.
+ * 		  For TYPE_DATA_CHAR the string follows the structure, for other types
+ * 		  the data is the pointer with number "binding" in the table given to the loader.
+ */
+
+typedef struct{
+
+	uint8_t type;					/*!< Type of the data, KDI_Type_data */
+
+	uint8_t reserved;				/*!< Always 0 */
+
+	uint16_t binding;				/*!< Number of the pointer in the table of bindings */
+
+}KDI_Menu_Image_Data;
+
 /*
  * @brief This enum used for menu nesting tracking
  */
@@ -58,9 +256,21 @@ typedef enum{
 	MENU_LEVEL_5		=	5,
 	MENU_LEVEL_6		=	6,
 	MENU_LEVEL_7		=	7,
+	MENU_LEVEL_MAX		=	32,		/*!< Deepest level, levels between are numbers, for example (KDI_Menu_Level)12 */
 
 }KDI_Menu_Level;
 
+/*
+ * @brief This enum used for status of the menu item pool
+ */
+
+typedef enum{
+
+	ITEM_POOL_OK		=	0,
+	ITEM_POOL_EMPTY		=	1,
+
+}KDI_Pool_status;
+
 /*
  * @brief Structure is one item menu.
  * 		  The structure works on the principle of linked lists.
@@ -70,24 +280,98 @@ typedef struct Menu_item{
 
 	void* data;							/*!< Pointer on data. Pointer void* type, need data type conversion required */
 
-	KDI_Type_data type		:4;			/*!< Enum for save type data. needed to permanently transform data in your functions*/
+	unsigned type			:4;			/*!< KDI_Type_data for save type data. Unsigned, a bitfield of enum type can be signed*/
 
-	KDI_Menu_Level level_menu	:4;		/*!< Enum for menu nesting tracking, 0 level is level data*/
+	unsigned level_menu		:6;			/*!< KDI_Menu_Level for menu nesting tracking, 0 level is level data, up to MENU_LEVEL_MAX. Unsigned, signed 6 bits do not keep 32*/
 
-	struct Menu_item* last_item;		/*!< Pointer on previous menu item*/
+	uint16_t id;						/*!< Number of the item, unique inside one menu*/
 
-	struct Menu_item* next_item;		/*!< Pointer on next menu item*/
+	KDI_Menu_link last_item;			/*!< Link on previous menu item*/
 
-	struct Menu_item* parent_item;		/*!< Pointer on parent menu item*/
+	KDI_Menu_link next_item;			/*!< Link on next menu item*/
+
+#if !KDI_MENU_BREADCRUMB
+	KDI_Menu_link parent_item;			/*!< Link on parent menu item*/
+#endif
 
-	struct Menu_item* child_item;		/*!< Pointer on child menu item*/
+	KDI_Menu_link child_item;			/*!< Link on child menu item*/
 
 
 }KDI_Menu_item;
 
+/*
+ * @brief State of the walk of the tree, see KDI_MenuItem_Walk_Start
+ */
+
+typedef struct{
+
+	KDI_Menu_item* head;						/*!< First item of the top level */
+
+	KDI_Menu_item* item;						/*!< Current item of the walk, 0 after the last item */
+
+	uint8_t depth;								/*!< Number of parents of the current item */
+
+	KDI_Menu_item* parents[MENU_LEVEL_MAX];		/*!< Parents of the current item, the first is on the top level */
+
+}KDI_Menu_Walk;
+
+/*
+ * @brief Conversion between link and pointer on menu item, 0 is no link
+ */
+#if KDI_MENU_ITEM_LINK_BITS == 0
+#define KDI_MENU_LINK_TO_ITEM(link)		(link)
+#define KDI_MENU_ITEM_TO_LINK(item)		(item)
+#define KDI_MENU_LINK(array, index)		(&(array)[index])
+#else
+extern KDI_Menu_item* KDI_Menu_item_array;
+#define KDI_MENU_LINK_TO_ITEM(link)		((link) ? &KDI_Menu_item_array[(link) - 1] : (KDI_Menu_item*)0)
+#define KDI_MENU_ITEM_TO_LINK(item)		((item) ? (KDI_Menu_link)((item) - KDI_Menu_item_array + 1) : (KDI_Menu_link)0)
+#define KDI_MENU_LINK(array, index)		((index) + 1)
+#endif
+#define KDI_MENU_NO_LINK				0
+
+/*
+ * @brief Fast access to linked menu items
+ */
+#define KDI_MENU_ITEM_NEXT(item)		KDI_MENU_LINK_TO_ITEM((item)->next_item)
+#define KDI_MENU_ITEM_LAST(item)		KDI_MENU_LINK_TO_ITEM((item)->last_item)
+#if !KDI_MENU_BREADCRUMB
+#define KDI_MENU_ITEM_PARENT(item)		KDI_MENU_LINK_TO_ITEM((item)->parent_item)
+#endif
+#define KDI_MENU_ITEM_CHILD(item)		KDI_MENU_LINK_TO_ITEM((item)->child_item)
+
+/*
+ * @brief Initializer of the constant menu item, links are KDI_MENU_LINK of the same array or KDI_MENU_NO_LINK
+ */
+#if !defined(__cplusplus) && !KDI_MENU_BREADCRUMB
+#define KDI_MENU_ITEM_CONST_ID(p_id, p_data, p_type, p_level, p_last, p_next, p_parent, p_child)	\
+	{	.data = (void*)(p_data), .type = (p_type), .level_menu = (p_level), .id = (p_id),		\
+		.last_item = (KDI_Menu_link)(p_last), .next_item = (KDI_Menu_link)(p_next),				\
+		.parent_item = (KDI_Menu_link)(p_parent), .child_item = (KDI_Menu_link)(p_child) }
+#elif !defined(__cplusplus)
+#define KDI_MENU_ITEM_CONST_ID(p_id, p_data, p_type, p_level, p_last, p_next, p_parent, p_child)	\
+	{	.data = (void*)(p_data), .type = (p_type), .level_menu = (p_level), .id = (p_id),		\
+		.last_item = (KDI_Menu_link)(p_last), .next_item = (KDI_Menu_link)(p_next),				\
+		.child_item = (KDI_Menu_link)(p_child) }
+#else
+#define KDI_MENU_ITEM_CONST_ID(p_id, p_data, p_type, p_level, p_last, p_next, p_parent, p_child)	\
+	KDI_MenuItem_Const((p_data), (p_type), (p_level), (p_last), (p_next), (p_parent), (p_child), (p_id))
+#endif
+#define KDI_MENU_ITEM_CONST(p_data, p_type, p_level, p_last, p_next, p_parent, p_child)	\
+	KDI_MENU_ITEM_CONST_ID(0, p_data, p_type, p_level, p_last, p_next, p_parent, p_child)
+
 /* Function get pointer on new menu item */
 KDI_Menu_item* KDI_GetMenu_item();
 
+/* Function return menu item in the pool */
+void KDI_FreeMenu_item(KDI_Menu_item* item);
+
+/* Functions for the menu item pool */
+void KDI_MenuItem_ResetPool(void);
+void KDI_MenuItem_SetArray(const KDI_Menu_item* array);
+KDI_Pool_status KDI_MenuItem_GetPoolStatus(void);
+unsigned int KDI_MenuItem_GetPoolFree(void);
+
 /* Functions set/get pointer on data */
 void KDI_MenuItem_SetData(KDI_Menu_item* item, void* data);
 void* KDI_MenuItem_GetData(KDI_Menu_item* item);
@@ -100,20 +384,69 @@ KDI_Type_data KDI_MenuItem_GetTypeData(KDI_Menu_item* item);
 void KDI_MenuItem_SetLevel(KDI_Menu_item* item, KDI_Menu_Level level);
 KDI_Menu_Level KDI_MenuItem_GetLevel(KDI_Menu_item* item);
 
+/* Functions set/get number of item*/
+void KDI_MenuItem_SetId(KDI_Menu_item* item, uint16_t id);
+uint16_t KDI_MenuItem_GetId(KDI_Menu_item* item);
+
 /* Function set link between menu item*/
 void KDI_MenuItem_SetLinkOnNextMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2);
 void KDI_MenuItem_SetLinkOnLastMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2);
+#if !KDI_MENU_BREADCRUMB
 void KDI_MenuItem_SetLinkOnParentMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2);
+#endif
 void KDI_MenuItem_SetLinkOnChildMenuItem(KDI_Menu_item* item1, KDI_Menu_item* item2);
 
 /* Function get link between menu item*/
 KDI_Menu_item* KDI_MenuItem_GetLinkOnNextMenuItem(KDI_Menu_item* item1);
 KDI_Menu_item* KDI_MenuItem_GetLinkOnLastMenuItem(KDI_Menu_item* item1);
+#if !KDI_MENU_BREADCRUMB
 KDI_Menu_item* KDI_MenuItem_GetLinkOnParentMenuItem(KDI_Menu_item* item1);
+#endif
 KDI_Menu_item* KDI_MenuItem_GetLinkOnChildMenuItem(KDI_Menu_item* item1);
 
+/* Function get next item of the tree in depth-first order */
+#if !KDI_MENU_BREADCRUMB
+KDI_Menu_item* KDI_MenuItem_GetNextInTree(KDI_Menu_item* item, KDI_Menu_item* head);
+#endif
+
+/* Functions walk the tree in depth-first order with the stack of parents */
+KDI_Menu_item* KDI_MenuItem_Walk_Start(KDI_Menu_Walk* walk, KDI_Menu_item* head);
+KDI_Menu_item* KDI_MenuItem_Walk_Next(KDI_Menu_Walk* walk);
+
 #ifdef __cplusplus
 }
+
+/*
+ * @brief Constant menu item for C++, used by KDI_MENU_ITEM_CONST
+ */
+#if KDI_MENU_ITEM_LINK_BITS == 0
+constexpr KDI_Menu_item KDI_MenuItem_Const(const void* data, KDI_Type_data type, KDI_Menu_Level level,
+											const KDI_Menu_item* last, const KDI_Menu_item* next,
+											const KDI_Menu_item* parent, const KDI_Menu_item* child, uint16_t id = 0){
+
+#if !KDI_MENU_BREADCRUMB
+	return KDI_Menu_item{ const_cast<void*>(data), type, level, id,
+						  const_cast<KDI_Menu_item*>(last), const_cast<KDI_Menu_item*>(next),
+						  const_cast<KDI_Menu_item*>(parent), const_cast<KDI_Menu_item*>(child) };
+#else
+	return (void)parent, KDI_Menu_item{ const_cast<void*>(data), type, level, id,
+						  const_cast<KDI_Menu_item*>(last), const_cast<KDI_Menu_item*>(next),
+						  const_cast<KDI_Menu_item*>(child) };
+#endif
+}
+#else
+constexpr KDI_Menu_item KDI_MenuItem_Const(const void* data, KDI_Type_data type, KDI_Menu_Level level,
+											KDI_Menu_link last, KDI_Menu_link next,
+											KDI_Menu_link parent, KDI_Menu_link child, uint16_t id = 0){
+
+#if !KDI_MENU_BREADCRUMB
+	return KDI_Menu_item{ const_cast<void*>(data), type, level, id, last, next, parent, child };
+#else
+	return (void)parent, KDI_Menu_item{ const_cast<void*>(data), type, level, id, last, next, child };
+#endif
+}
+#endif
+
 #endif
 
 #endif /* SRC_KDI_MENU_ITEM_H_ */
@@ -0,0 +1,150 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Queue.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Queue module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for pass menu commands from interrupts to the main loop. Buttons and encoders
+ * put commands in the queue in their interrupts, the main loop takes all commands from the queue,
+ * moves the menu and displays it once. The queue has one writer (interrupt) and one reader (main loop),
+ * so locks and disabling interrupts are not needed.
+ *
+ * 									##### How to use this driver #####
+ * 1) Declare a structure KDI_Menu_Queue and use function KDI_Menu_Queue_Init.
+ * 2) In the interrupt of a button or encoder use function KDI_Menu_Queue_Post.
+ * 3) In the main loop use function KDI_Menu_Queue_Pump instead of KDI_Menu_Drive and KDI_Menu_Handler.
+ *
+ * 	Counters head and tail are one byte, reading and writing of one byte is atomic on all microcontrollers.
+ * 	Each counter is written only by one side. The command is written in the buffer before head is changed,
+ * 	so the main loop never reads a command that is not yet written.
+ *
+ */
+
+#include "KDI_Menu_Queue.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief 		Initialization queue
+  * @param  	Pointer on KDI_Menu_Queue
+  *	@return		Nope
+  *
+  * @note		Call before interrupts that use the queue are enabled.
+  */
+
+void KDI_Menu_Queue_Init(KDI_Menu_Queue* queue){
+
+	/* Queue is empty*/
+	queue->head = 0;
+
+	queue->tail = 0;
+
+	queue->lost = 0;
+}
+
+/**
+  * @brief 		Put command in the queue
+  *
+  * @param  	Pointer on KDI_Menu_Queue
+  *	@param		Menu navigation command.
+  *				This parameter can be one of the KDI_Menu_Command enum values:
+  *					@arg MENU_COMMAND_FORWARD
+  *					@arg MENU_COMMAND_BACKWARD
+  *					@arg MENU_COMMAND_UP
+  *					@arg MENU_COMMAND_DOWN
+  *
+  *	@return		MENU_STATUS_OK or MENU_STATUS_QUEUE_FULL
+  *
+  * @note		Can be called from one interrupt only.
+  */
+
+KDI_Menu_Status KDI_Menu_Queue_Post(KDI_Menu_Queue* queue, KDI_Menu_Command command){
+
+	/* Copy counter written by this side*/
+	uint8_t head = queue->head;
+
+	/* Check free place*/
+	if((uint8_t)(head - queue->tail) >= KDI_MENU_QUEUE_SIZE){
+
+		/* Count lost command*/
+		queue->lost++;
+		return MENU_STATUS_QUEUE_FULL;
+	}
+
+	/* Save command*/
+	queue->buffer[head & (KDI_MENU_QUEUE_SIZE - 1)] = (uint8_t)command;
+
+	/* Publish command*/
+	queue->head = head + 1;
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Execute all commands from the queue and display the menu
+  *
+  * @param  	Pointer on KDI_Menu_Queue
+  * @param  	Pointer on KDI_Menu
+  *
+  *	@return		Number of executed commands
+  *
+  * @note		Forward and backward commands in a row are done by one KDI_Menu_Step, see KDI_Menu_Drive_Join.
+  * 			KDI_Menu_Handler is called once after all commands,
+  * 			it prints only if the item or the value changed.
+  */
+
+unsigned int KDI_Menu_Queue_Pump(KDI_Menu_Queue* queue, KDI_Menu* menu){
+
+	/* Copy counter written by this side*/
+	uint8_t tail = queue->tail;
+
+	/* Copy counter written by the interrupt, new commands are taken on the next call*/
+	uint8_t head = queue->head;
+
+	/* Number of commands*/
+	unsigned int count = (uint8_t)(head - tail);
+
+	/* Sum of forward and backward commands*/
+	int steps = 0;
+
+	/* Execute commands*/
+	while(tail != head){
+
+		/* Take command*/
+		KDI_Menu_Command command = (KDI_Menu_Command)queue->buffer[tail & (KDI_MENU_QUEUE_SIZE - 1)];
+
+		/* Free place in the queue*/
+		queue->tail = ++tail;
+
+		/* Add forward and backward commands, execute other*/
+		steps = KDI_Menu_Drive_Join(menu, steps, command);
+	}
+
+	/* Do the rest moves*/
+	KDI_Menu_Step(menu, steps);
+
+	/* Display menu*/
+	KDI_Menu_Handler(menu);
+
+	return count;
+}
+
+/**
+  * @brief 		Get number of commands lost because the queue was full
+  *
+  * @param  	Pointer on KDI_Menu_Queue
+  *	@return		Number of lost commands
+  */
+
+uint8_t KDI_Menu_Queue_Get_Lost(KDI_Menu_Queue* queue){
+
+	/* Return number of lost commands*/
+	return queue->lost;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,93 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Queue.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Queue module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for pass menu commands from interrupts to the main loop. Buttons and encoders
+ * put commands in the queue in their interrupts, the main loop takes all commands from the queue,
+ * moves the menu and displays it once. The queue has one writer (interrupt) and one reader (main loop),
+ * so locks and disabling interrupts are not needed.
+ *
+ * 									##### How to use this driver #####
+ * 1) Declare a structure KDI_Menu_Queue and use function KDI_Menu_Queue_Init.
+ * 2) In the interrupt of a button or encoder use function KDI_Menu_Queue_Post.
+ * 3) In the main loop use function KDI_Menu_Queue_Pump instead of KDI_Menu_Drive and KDI_Menu_Handler.
+ *
+ * 									#### Example Used Library ####
+ *
+ * 		KDI_Menu_Queue MyQueue;
+ *
+ * 		KDI_Menu_Queue_Init(&MyQueue);
+ *
+ * 		void EXTI0_IRQHandler(void){
+ *
+ * 			KDI_Menu_Queue_Post(&MyQueue, MENU_COMMAND_FORWARD);
+ * 		}
+ *
+ * 		while(1){
+ *
+ * 			KDI_Menu_Queue_Pump(&MyQueue, &MyMenu);
+ * 		}
+ *
+ */
+
+#ifndef KDI_MENU_QUEUE_H_
+#define KDI_MENU_QUEUE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu.h
+ * 			Commands from the queue are executed by this library
+ *
+ */
+#include "KDI_Menu.h"
+
+/*
+ * @brief	Number of commands in the queue, must be a power of two and not more than 128
+ */
+#ifndef KDI_MENU_QUEUE_SIZE
+#define KDI_MENU_QUEUE_SIZE		16
+#endif
+
+#if (KDI_MENU_QUEUE_SIZE & (KDI_MENU_QUEUE_SIZE - 1)) || (KDI_MENU_QUEUE_SIZE > 128)
+#error "KDI_MENU_QUEUE_SIZE must be a power of two and not more than 128"
+#endif
+
+/*
+ * @brief	Queue of menu commands
+ */
+
+typedef struct Menu_Queue{
+
+	volatile uint8_t head;								/*!< Number of posted commands, written only by the interrupt */
+
+	volatile uint8_t tail;								/*!< Number of executed commands, written only by the main loop */
+
+	volatile uint8_t lost;								/*!< Number of commands lost because the queue was full */
+
+	volatile uint8_t buffer[KDI_MENU_QUEUE_SIZE];		/*!< Commands, type KDI_Menu_Command */
+
+}KDI_Menu_Queue;
+
+/*Initialization function */
+void KDI_Menu_Queue_Init(KDI_Menu_Queue* queue);
+
+/*Function for the interrupt */
+KDI_Menu_Status KDI_Menu_Queue_Post(KDI_Menu_Queue* queue, KDI_Menu_Command command);
+
+/*Function for the main loop */
+unsigned int KDI_Menu_Queue_Pump(KDI_Menu_Queue* queue, KDI_Menu* menu);
+
+/*Function get number of lost commands */
+uint8_t KDI_Menu_Queue_Get_Lost(KDI_Menu_Queue* queue);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_QUEUE_H_ */
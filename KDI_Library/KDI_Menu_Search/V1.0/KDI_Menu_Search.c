@@ -0,0 +1,252 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Search.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Search module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for find items by the start of their string, see KDI_Menu_Search.h.
+ *
+ * The table is sorted by heapsort: no recursion, no memory except the table and the time
+ * does not depend on the order of the items in the menu.
+ *
+ */
+
+#include "KDI_Menu_Search.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief 		Get string of item without spaces before
+  * @param  	Pointer on KDI_Menu_item
+  *	@return		String
+  */
+
+static const unsigned char* KDI_Menu_Search_Label(const KDI_Menu_item* item){
+
+	const unsigned char* label = (const unsigned char*)KDI_Menu_Type_Label(item);
+
+	/* Skip spaces before*/
+	while(*label == ' ') label++;
+
+	return label;
+}
+
+/**
+  * @brief 		Compare strings of two items
+  *
+  * @param  	Pointer on first KDI_Menu_item
+  * @param  	Pointer on second KDI_Menu_item
+  *	@return		Less than 0, 0 or more than 0, as strcmp
+  */
+
+static int KDI_Menu_Search_Compare(const KDI_Menu_item* first, const KDI_Menu_item* second){
+
+	const unsigned char* a = KDI_Menu_Search_Label(first);
+
+	const unsigned char* b = KDI_Menu_Search_Label(second);
+
+	while(*a && *a == *b){
+
+		a++;
+		b++;
+	}
+
+	return (int)*a - (int)*b;
+}
+
+/**
+  * @brief 		Compare start of the string of item with prefix
+  *
+  * @param  	Pointer on KDI_Menu_item
+  * @param  	Prefix
+  *	@return		Less than 0, 0 if the string starts with prefix, more than 0
+  */
+
+static int KDI_Menu_Search_Compare_Prefix(const KDI_Menu_item* item, const unsigned char* prefix){
+
+	const unsigned char* label = KDI_Menu_Search_Label(item);
+
+	while(*prefix){
+
+		if(*label != *prefix) return (int)*label - (int)*prefix;
+
+		label++;
+		prefix++;
+	}
+
+	return 0;
+}
+
+/**
+  * @brief 		Move item down in the heap
+  *
+  * @param  	Table
+  * @param  	Number of item
+  * @param  	Size of the heap
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Search_Sift(KDI_Menu_item** table, uint16_t number, uint16_t size){
+
+	KDI_Menu_item* item = table[number];
+
+	while(1){
+
+		uint32_t child = 2U * number + 1U;
+
+		if(child >= size) break;
+
+		/* Bigger child*/
+		if(child + 1U < size && KDI_Menu_Search_Compare(table[child + 1U], table[child]) > 0) child++;
+
+		if(KDI_Menu_Search_Compare(table[child], item) <= 0) break;
+
+		table[number] = table[child];
+
+		number = (uint16_t)child;
+	}
+
+	table[number] = item;
+}
+
+/**
+  * @brief 		Find first item with string not less than prefix
+  *
+  * @param  	Pointer on KDI_Menu_Search
+  * @param  	Prefix
+  * @param  	0 - first string which starts with prefix, 1 - first string after them
+  *	@return		Number of item in the table
+  */
+
+static uint16_t KDI_Menu_Search_Bound(const KDI_Menu_Search* search, const unsigned char* prefix, uint8_t after){
+
+	uint16_t low = 0;
+
+	uint16_t high = search->count;
+
+	while(low < high){
+
+		uint16_t middle = (uint16_t)(low + (high - low) / 2U);
+
+		int result = KDI_Menu_Search_Compare_Prefix(search->table[middle], prefix);
+
+		if(result < 0 || (after && result == 0)) low = middle + 1U;
+		else high = middle;
+	}
+
+	return low;
+}
+
+/**
+  * @brief 		Initialization search index
+  *
+  * @param  	Pointer on KDI_Menu_Search
+  * @param  	Pointer on created KDI_Menu
+  * @param  	Table of the program
+  * @param  	Size of the table
+  *	@return		Number of saved items
+  *
+  * @note		Items with strings are saved, if the table is full other items are not saved.
+  */
+
+uint16_t KDI_Menu_Search_Init(KDI_Menu_Search* search, KDI_Menu* menu, KDI_Menu_item** table, uint16_t size){
+
+	search->menu = menu;
+
+	search->table = table;
+
+	search->count = 0;
+
+	KDI_Menu_Walk walk;
+
+	/* Save all items with strings*/
+	for(KDI_Menu_item* item = KDI_MenuItem_Walk_Start(&walk, menu->Head); item && search->count < size; item = KDI_MenuItem_Walk_Next(&walk)){
+
+		if(KDI_Menu_Type_Label(item)) table[search->count++] = item;
+	}
+
+	/* Make heap*/
+	for(uint16_t i = search->count / 2U; i > 0; i--) KDI_Menu_Search_Sift(table, i - 1U, search->count);
+
+	/* Move the biggest item to the end*/
+	for(uint16_t last = search->count; last > 1; last--){
+
+		KDI_Menu_item* item = table[0];
+
+		table[0] = table[last - 1U];
+
+		table[last - 1U] = item;
+
+		KDI_Menu_Search_Sift(table, 0, last - 1U);
+	}
+
+	return search->count;
+}
+
+/**
+  * @brief 		Find items which strings start with prefix
+  *
+  * @param  	Pointer on KDI_Menu_Search
+  * @param  	Prefix, spaces before it are skipped, "" - all items
+  * @param  	Number of the first found item in the table, can be 0
+  *	@return		Number of found items, they are in the table one after another
+  */
+
+uint16_t KDI_Menu_Search_Find(const KDI_Menu_Search* search, const char* prefix, uint16_t* first){
+
+	const unsigned char* start = (const unsigned char*)prefix;
+
+	/* Skip spaces before*/
+	while(*start == ' ') start++;
+
+	uint16_t low = KDI_Menu_Search_Bound(search, start, 0);
+
+	uint16_t high = KDI_Menu_Search_Bound(search, start, 1);
+
+	if(first) *first = low;
+
+	return (uint16_t)(high - low);
+}
+
+/**
+  * @brief 		Get item from the table
+  *
+  * @param  	Pointer on KDI_Menu_Search
+  * @param  	Number of item in the table
+  *	@return		Pointer on item, 0 if number is not less than the number of items
+  */
+
+KDI_Menu_item* KDI_Menu_Search_Get(const KDI_Menu_Search* search, uint16_t number){
+
+	if(number >= search->count) return 0;
+
+	return search->table[number];
+}
+
+/**
+  * @brief 		Go to the first item which string starts with prefix
+  *
+  * @param  	Pointer on KDI_Menu_Search
+  * @param  	Prefix
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND or MENU_STATUS_LEVEL_ERROR
+  *
+  * @note		Current item and level of the menu are set by KDI_Menu_Jump_Item.
+  */
+
+KDI_Menu_Status KDI_Menu_Search_Jump(KDI_Menu_Search* search, const char* prefix){
+
+	uint16_t first;
+
+	/* Find item*/
+	if(!KDI_Menu_Search_Find(search, prefix, &first)) return MENU_STATUS_NOT_FOUND;
+
+	/* Go to item*/
+	return KDI_Menu_Jump_Item(search->menu, search->table[first]);
+}
+
+#ifdef __cplusplus
+}
+#endif
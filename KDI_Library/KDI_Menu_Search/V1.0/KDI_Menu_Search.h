@@ -0,0 +1,78 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Search.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Search module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for find items of a big menu by the start of their string, for example when the operator
+ * types "Tem" on a terminal instead of many KDI_Menu_Drive steps.
+ *
+ * After the menu is created, items with strings (see KDI_Menu_Type_Label) are saved in a table of the program
+ * and the table is sorted by strings once. Items with the same start of the string are together in the table,
+ * they are found by two binary searches, so a search of 2000 items compares about 22 strings.
+ * Spaces before the string are skipped, letters are compared with case.
+ *
+ * 									##### How to use this driver #####
+ * 1) Create menu KDI_Menu.
+ * 2) Declare a structure KDI_Menu_Search, a table with one pointer for each item and use function KDI_Menu_Search_Init:
+ *
+ * 		KDI_Menu_item* Search_table[100];
+ *
+ * 		KDI_Menu_Search_Init(&MySearch, &MyMenu, Search_table, 100);
+ *
+ * 3) Find items:
+ *
+ * 		uint16_t first;
+ * 		uint16_t count = KDI_Menu_Search_Find(&MySearch, "Tem", &first);
+ *
+ * 		for(uint16_t i = 0; i < count; i++) print(KDI_Menu_Type_Label(KDI_Menu_Search_Get(&MySearch, first + i)));
+ *
+ * 4) Go to the found item: KDI_Menu_Jump_Item(&MyMenu, KDI_Menu_Search_Get(&MySearch, first)),
+ *    or to the first item with the start of the string: KDI_Menu_Search_Jump(&MySearch, "Tem").
+ *
+ * Call KDI_Menu_Search_Init again if items were added or strings were changed.
+ *
+ */
+
+#ifndef KDI_MENU_SEARCH_H_
+#define KDI_MENU_SEARCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu_Type.h
+ * 			Strings of items are got by this library
+ *
+ */
+#include "KDI_Menu_Type.h"
+
+/*
+ * @brief	Structure of the search index
+ */
+
+typedef struct Menu_Search{
+
+	KDI_Menu* menu;					/*!< Menu of the items */
+
+	KDI_Menu_item** table;			/*!< Items sorted by strings */
+
+	uint16_t count;					/*!< Number of items in the table */
+
+}KDI_Menu_Search;
+
+/*Initialization function */
+uint16_t KDI_Menu_Search_Init(KDI_Menu_Search* search, KDI_Menu* menu, KDI_Menu_item** table, uint16_t size);
+
+/*Search functions */
+uint16_t KDI_Menu_Search_Find(const KDI_Menu_Search* search, const char* prefix, uint16_t* first);
+KDI_Menu_item* KDI_Menu_Search_Get(const KDI_Menu_Search* search, uint16_t number);
+KDI_Menu_Status KDI_Menu_Search_Jump(KDI_Menu_Search* search, const char* prefix);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_SEARCH_H_ */
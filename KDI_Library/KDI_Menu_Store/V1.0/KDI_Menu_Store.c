@@ -0,0 +1,491 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Store.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Store module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for save values of items in a journal in flash.
+ *
+ * 	Sector:
+ * 		header					-	KDI_MENU_STORE_MAGIC and sequence number, 8 bytes, written last, the magic after the number;
+ * 		records					-	values of all items written when the sector was started;
+ * 		records					-	changed values, a later record of the same item replaces the earlier.
+ *
+ * Records are written in parts of KDI_MENU_STORE_BATCH. A record with wrong check (writing was stopped by reset)
+ * is skipped, the first erased record is the end of the journal. The check is CRC-16 and it is never 0xFFFF,
+ * so a record with erased check is not valid for any number and value. Bits of changed values are cleared
+ * only after their part is written. If writing fails, the sector is ended, the next flush starts the next sector
+ * with all values, so records after a gap of erased flash are never lost.
+ *
+ */
+
+#include "KDI_Menu_Store.h"
+
+/**
+ * @brief Includes table of functions of types of data
+ */
+#include "KDI_Menu_Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size of the header of a sector
+ */
+#define KDI_MENU_STORE_HEADER		sizeof(KDI_Menu_Store_Record)
+
+/**
+ * @brief 		Check of record, CRC-16 (polynomial 0x1021) of number and value
+ *
+ * @param  		Number of the item
+ * @param  		Value of the item
+ * @return		Check, it is not 0xFFFF for erased flash
+ */
+
+static uint16_t KDI_Menu_Store_Check(uint16_t id, int32_t value){
+
+	/* Bytes in the same order on any processor*/
+	uint8_t bytes[6] = {(uint8_t)id, (uint8_t)(id >> 8), (uint8_t)value, (uint8_t)((uint32_t)value >> 8),
+						(uint8_t)((uint32_t)value >> 16), (uint8_t)((uint32_t)value >> 24)};
+
+	uint16_t crc = 0xFFFF;
+
+	for(uint8_t i = 0; i < sizeof(bytes); i++){
+
+		crc ^= (uint16_t)(bytes[i] << 8);
+
+		for(uint8_t bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+	}
+
+	/* Erased check is never valid*/
+	return (crc == 0xFFFF) ? 0 : crc;
+}
+
+/**
+ * @brief 		Get saved item by number
+ *
+ * @param  		Pointer on KDI_Menu_Store
+ * @param  		Number of the item
+ * @param  		Pointer on limits of the value, 0 - limits are not needed
+ * @return		Pointer on the item or 0 if the item is not saved
+ */
+
+static KDI_Menu_item* KDI_Menu_Store_Item(KDI_Menu_Store* store, uint16_t id, KDI_Menu_Edit* limits){
+
+	KDI_Menu_Edit edit;
+
+	if(id >= store->menu->id_table_size) return 0;
+
+	KDI_Menu_item* item = store->menu->id_table[id];
+
+	/* Only items which can be edited*/
+	if(!item || !KDI_Menu_types[item->type].edit(item->data, limits ? limits : &edit)) return 0;
+
+	return item;
+}
+
+/**
+ * @brief 		Function of KDI_Menu_Set_Commit, marks the value written by edit mode
+ *
+ * @param  		Pointer on KDI_Menu_Store
+ * @param  		Pointer on the item
+ * @return		Nope
+ */
+
+static void KDI_Menu_Store_Commit(void* context, KDI_Menu_item* item){
+
+	KDI_Menu_Store_Changed((KDI_Menu_Store*)context, KDI_MenuItem_GetId(item));
+}
+
+/**
+ * @brief 		Write records to current sector
+ *
+ * @param  		Pointer on KDI_Menu_Store
+ * @param  		Records
+ * @param  		Number of records
+ * @return		1 if done
+ */
+
+static uint8_t KDI_Menu_Store_Write(KDI_Menu_Store* store, const KDI_Menu_Store_Record* records, uint32_t count){
+
+	if(!count) return 1;
+
+	uint32_t address = (uint32_t)store->sector * store->flash->sector_size + store->position;
+
+	store->position += count * sizeof(KDI_Menu_Store_Record);
+
+	if(store->flash->write(address, records, count * sizeof(KDI_Menu_Store_Record))) return 1;
+
+	/* Records after not written flash would not be read, the next flush starts the next sector*/
+	store->position = store->flash->sector_size;
+
+	return 0;
+}
+
+/**
+ * @brief 		Clear bits of written values
+ *
+ * @param  		Pointer on KDI_Menu_Store
+ * @param  		Written records
+ * @param  		Number of records
+ * @return		Nope
+ */
+
+static void KDI_Menu_Store_Clean(KDI_Menu_Store* store, const KDI_Menu_Store_Record* records, uint32_t count){
+
+	for(uint32_t i = 0; i < count; i++){
+
+		store->dirty[records[i].id / 32] &= ~(1UL << (records[i].id % 32));
+
+		store->dirty_count--;
+	}
+}
+
+/**
+ * @brief 		Start the next sector with values of all items
+ *
+ * @param  		Pointer on KDI_Menu_Store
+ * @return		MENU_STATUS_OK or MENU_STATUS_FLASH_ERROR
+ *
+ * @note		The header is written last, until then the old sector is current after reset.
+ * 				The store goes to the new sector only after its header, so after an error
+ * 				the old sector stays current and the next flush starts the same sector again.
+ */
+
+static KDI_Menu_Status KDI_Menu_Store_Next_Sector(KDI_Menu_Store* store){
+
+	const KDI_Menu_Store_Flash* flash = store->flash;
+
+	KDI_Menu_Store_Record batch[KDI_MENU_STORE_BATCH];
+
+	uint32_t count = 0;
+
+	/* New sector and its number*/
+	uint16_t sector = (uint16_t)((store->sector + 1) % flash->sector_count);
+
+	uint32_t sequence = store->sequence + 1;
+
+	uint32_t address = (uint32_t)sector * flash->sector_size;
+
+	uint32_t position = KDI_MENU_STORE_HEADER;
+
+	/* Old sector is not written any more, records of the next flush go to the new sector*/
+	store->position = flash->sector_size;
+
+	/* Erase next sector*/
+	if(!flash->erase(address)) return MENU_STATUS_FLASH_ERROR;
+
+	/* Values of all items*/
+	for(uint16_t id = 0; id < store->menu->id_table_size; id++){
+
+		KDI_Menu_item* item = KDI_Menu_Store_Item(store, id, 0);
+
+		if(!item) continue;
+
+		batch[count].id = id;
+		batch[count].value = KDI_Menu_types[item->type].read(item->data);
+		batch[count].check = KDI_Menu_Store_Check(id, batch[count].value);
+
+		if(++count < KDI_MENU_STORE_BATCH) continue;
+
+		if(!flash->write(address + position, batch, count * sizeof(KDI_Menu_Store_Record))) return MENU_STATUS_FLASH_ERROR;
+
+		position += count * sizeof(KDI_Menu_Store_Record);
+
+		count = 0;
+	}
+
+	/* Rest of records*/
+	if(count){
+
+		if(!flash->write(address + position, batch, count * sizeof(KDI_Menu_Store_Record))) return MENU_STATUS_FLASH_ERROR;
+
+		position += count * sizeof(KDI_Menu_Store_Record);
+	}
+
+	/* Header, the magic is written after the number, so a header stopped by reset is not valid*/
+	uint32_t header[2] = {KDI_MENU_STORE_MAGIC, sequence};
+
+	if(!flash->write(address + sizeof(uint32_t), &header[1], sizeof(uint32_t))) return MENU_STATUS_FLASH_ERROR;
+
+	if(!flash->write(address, &header[0], sizeof(uint32_t))) return MENU_STATUS_FLASH_ERROR;
+
+	/* New sector is current*/
+	store->sector = sector;
+
+	store->sequence = sequence;
+
+	store->position = position;
+
+	/* All values are saved*/
+	for(uint16_t i = 0; i < KDI_MENU_STORE_DIRTY_SIZE(store->menu->id_table_size); i++) store->dirty[i] = 0;
+
+	store->dirty_count = 0;
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Init the store
+  *
+  * @param  	Pointer on KDI_Menu_Store
+  * @param  	Pointer on KDI_Menu, KDI_Menu_Set_Id_Table must be called before
+  * @param  	Pointer on functions of the flash
+  * @param  	Table of KDI_MENU_STORE_DIRTY_SIZE(size of table of items) words
+  * @param		Pointer on function type "uint32_t name_fuction(void)", for example time in milliseconds,
+  * 			0 - values are written on each call of KDI_Menu_Store_Handler
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND without table of items
+  * 			or MENU_STATUS_NO_MEMORY if values of all items are more than a sector
+  *
+  * @note		The store uses KDI_Menu_Set_Commit of the menu.
+  */
+
+KDI_Menu_Status KDI_Menu_Store_Init(KDI_Menu_Store* store, KDI_Menu* menu, const KDI_Menu_Store_Flash* flash,
+									uint32_t* dirty, uint32_t(*get_time)(void)){
+
+	store->menu = menu;
+
+	store->flash = flash;
+
+	store->dirty = dirty;
+
+	store->get_time = get_time;
+
+	store->sector = 0;
+
+	store->sequence = 0;
+
+	store->position = flash->sector_size;
+
+	if(!menu->id_table) return MENU_STATUS_NOT_FOUND;
+
+	/* Values of all items must fit in one sector*/
+	uint32_t size = KDI_MENU_STORE_HEADER;
+
+	for(uint16_t id = 0; id < menu->id_table_size; id++){
+
+		if(KDI_Menu_Store_Item(store, id, 0)) size += sizeof(KDI_Menu_Store_Record);
+	}
+
+	if(flash->sector_count < 2 || flash->sector_size % sizeof(KDI_Menu_Store_Record) || size > flash->sector_size) return MENU_STATUS_NO_MEMORY;
+
+	/* Nothing changed*/
+	for(uint16_t i = 0; i < KDI_MENU_STORE_DIRTY_SIZE(menu->id_table_size); i++) dirty[i] = 0;
+
+	store->dirty_count = 0;
+
+	/* Values written by edit mode*/
+	KDI_Menu_Set_Commit(menu, KDI_Menu_Store_Commit, store);
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Restore saved values
+  *
+  * @param  	Pointer on KDI_Menu_Store
+  *	@return		MENU_STATUS_OK, MENU_STATUS_NOT_FOUND if the journal is empty (it is started with current values)
+  * 			or MENU_STATUS_FLASH_ERROR
+  *
+  * @note		Values outside the limits of their items are not restored.
+  */
+
+KDI_Menu_Status KDI_Menu_Store_Restore(KDI_Menu_Store* store){
+
+	const KDI_Menu_Store_Flash* flash = store->flash;
+
+	uint8_t found = 0;
+
+	/* Find current sector by headers*/
+	for(uint16_t sector = 0; sector < flash->sector_count; sector++){
+
+		uint32_t header[2];
+
+		if(!flash->read((uint32_t)sector * flash->sector_size, header, sizeof(header))) return MENU_STATUS_FLASH_ERROR;
+
+		if(header[0] != KDI_MENU_STORE_MAGIC) continue;
+
+		/* Biggest sequence number, also after overflow*/
+		if(!found || (int32_t)(header[1] - store->sequence) > 0){
+
+			store->sector = sector;
+
+			store->sequence = header[1];
+
+			found = 1;
+		}
+	}
+
+	/* Empty journal, start it with current values*/
+	if(!found){
+
+		store->sector = (uint16_t)(flash->sector_count - 1);
+
+		store->sequence = 0;
+
+		if(KDI_Menu_Store_Next_Sector(store) != MENU_STATUS_OK) return MENU_STATUS_FLASH_ERROR;
+
+		return MENU_STATUS_NOT_FOUND;
+	}
+
+	/* Read records until erased flash*/
+	KDI_Menu_Store_Record batch[KDI_MENU_STORE_BATCH];
+
+	uint32_t address = (uint32_t)store->sector * flash->sector_size;
+
+	store->position = KDI_MENU_STORE_HEADER;
+
+	while(store->position < flash->sector_size){
+
+		uint32_t count = (flash->sector_size - store->position) / sizeof(KDI_Menu_Store_Record);
+
+		if(count > KDI_MENU_STORE_BATCH) count = KDI_MENU_STORE_BATCH;
+
+		if(!flash->read(address + store->position, batch, count * sizeof(KDI_Menu_Store_Record))) return MENU_STATUS_FLASH_ERROR;
+
+		for(uint32_t i = 0; i < count; i++){
+
+			KDI_Menu_Store_Record* record = &batch[i];
+
+			/* End of the journal*/
+			if(record->id == 0xFFFF && record->check == 0xFFFF && record->value == -1) return MENU_STATUS_OK;
+
+			store->position += sizeof(KDI_Menu_Store_Record);
+
+			/* Broken record*/
+			if(record->check != KDI_Menu_Store_Check(record->id, record->value)) continue;
+
+			KDI_Menu_Edit limits;
+
+			KDI_Menu_item* item = KDI_Menu_Store_Item(store, record->id, &limits);
+
+			if(!item || record->value < limits.min || record->value > limits.max) continue;
+
+			KDI_Menu_types[item->type].write(item->data, record->value);
+		}
+	}
+
+	return MENU_STATUS_OK;
+}
+
+/**
+  * @brief 		Mark changed value
+  *
+  * @param  	Pointer on KDI_Menu_Store
+  * @param		Number of the item
+  *	@return		Nope
+  *
+  * @note		Called by edit mode, call it for values changed by the program.
+  */
+
+void KDI_Menu_Store_Changed(KDI_Menu_Store* store, uint16_t id){
+
+	if(id >= store->menu->id_table_size) return;
+
+	/* Time of the last change*/
+	if(store->get_time) store->change_time = store->get_time();
+
+	uint32_t bit = 1UL << (id % 32);
+
+	if(store->dirty[id / 32] & bit) return;
+
+	store->dirty[id / 32] |= bit;
+
+	store->dirty_count++;
+}
+
+/**
+  * @brief 		Write changed values after KDI_MENU_STORE_IDLE_TIME without changes
+  * @param  	Pointer on KDI_Menu_Store
+  *	@return		MENU_STATUS_OK or MENU_STATUS_FLASH_ERROR
+  */
+
+KDI_Menu_Status KDI_Menu_Store_Handler(KDI_Menu_Store* store){
+
+	if(!store->dirty_count) return MENU_STATUS_OK;
+
+	/* Values are still changed*/
+	if(store->get_time && store->get_time() - store->change_time < KDI_MENU_STORE_IDLE_TIME) return MENU_STATUS_OK;
+
+	return KDI_Menu_Store_Flush(store);
+}
+
+/**
+  * @brief 		Write changed values now
+  * @param  	Pointer on KDI_Menu_Store
+  *	@return		MENU_STATUS_OK or MENU_STATUS_FLASH_ERROR
+  *
+  * @note		If changed values do not fit in current sector, the next sector is started.
+  */
+
+KDI_Menu_Status KDI_Menu_Store_Flush(KDI_Menu_Store* store){
+
+	if(!store->dirty_count) return MENU_STATUS_OK;
+
+	/* Next sector has all values*/
+	if(store->position + (uint32_t)store->dirty_count * sizeof(KDI_Menu_Store_Record) > store->flash->sector_size){
+
+		return KDI_Menu_Store_Next_Sector(store);
+	}
+
+	KDI_Menu_Store_Record batch[KDI_MENU_STORE_BATCH];
+
+	uint32_t count = 0;
+
+	/* Records of marked values*/
+	for(uint16_t i = 0; i < KDI_MENU_STORE_DIRTY_SIZE(store->menu->id_table_size); i++){
+
+		/* Bits are cleared after writing*/
+		uint32_t bits = store->dirty[i];
+
+		while(bits){
+
+			uint8_t bit = 0;
+
+			while(!(bits & (1UL << bit))) bit++;
+
+			bits &= ~(1UL << bit);
+
+			uint16_t id = (uint16_t)(i * 32 + bit);
+
+			KDI_Menu_item* item = KDI_Menu_Store_Item(store, id, 0);
+
+			/* Value of not saved item is only cleared*/
+			if(!item){
+
+				store->dirty[i] &= ~(1UL << bit);
+
+				store->dirty_count--;
+				continue;
+			}
+
+			batch[count].id = id;
+			batch[count].value = KDI_Menu_types[item->type].read(item->data);
+			batch[count].check = KDI_Menu_Store_Check(id, batch[count].value);
+
+			if(++count < KDI_MENU_STORE_BATCH) continue;
+
+			if(!KDI_Menu_Store_Write(store, batch, count)) return MENU_STATUS_FLASH_ERROR;
+
+			KDI_Menu_Store_Clean(store, batch, count);
+
+			count = 0;
+		}
+	}
+
+	/* Rest of records*/
+	if(count){
+
+		if(!KDI_Menu_Store_Write(store, batch, count)) return MENU_STATUS_FLASH_ERROR;
+
+		KDI_Menu_Store_Clean(store, batch, count);
+	}
+
+	return MENU_STATUS_OK;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,162 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Store.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Store module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for save values of items of the data level in flash or EEPROM and restore them after reset.
+ * Values are saved by number of item (see KDI_Menu_Set_Id_Table), only items which can be edited
+ * (see KDI_Menu_Edit_Start) are saved.
+ *
+ * Changed values are marked in a table of bits. Nothing is written while values are changed: after
+ * KDI_MENU_STORE_IDLE_TIME without changes all marked values are written as records of 8 bytes
+ * at the end of the journal. So many steps of an encoder give one write.
+ *
+ * The journal uses sectors of flash one after another. When the current sector is full, the next sector
+ * is erased, the values of all items are written to it and its header is written last, then it becomes
+ * current. So all sectors are erased the same number of times, and after a reset during writing the old
+ * sector is still valid. The last sector has the biggest sequence number in its header. If the flash fails
+ * while the next sector is started, the old sector stays current and the next flush starts the same sector again.
+ *
+ * Restoring reads the headers of sectors and then the last sector once from start to end.
+ *
+ * The flash is given as a structure of functions, KDI_Menu_Store_File_Open gives such structure
+ * for a file on the computer, it is used by the host test KDI_Menu_Test_Store.
+ *
+ * 									##### How to use this driver #####
+ * 1) Write functions of the flash: read, write without erase (bits only go from 1 to 0) and erase of a sector.
+ * 	  Functions return 1 if done.
+ *
+ * 		const KDI_Menu_Store_Flash MyFlash = {2048, 2, flash_read, flash_write, flash_erase};
+ *
+ * 2) Make the menu, KDI_Menu_Set_Id_Table, then init the store and restore values:
+ *
+ * 		uint32_t MyDirty[KDI_MENU_STORE_DIRTY_SIZE(ITEM_COUNT)];
+ *
+ * 		KDI_Menu_Store_Init(&MyStore, &MyMenu, &MyFlash, MyDirty, get_time_ms);
+ *
+ * 		KDI_Menu_Store_Restore(&MyStore);
+ *
+ * 	  Values written by edit mode are marked by the store. Mark values changed by the program:
+ *
+ * 		KDI_Menu_Store_Changed(&MyStore, SPEED_ID);
+ *
+ * 3) Call KDI_Menu_Store_Handler in the main loop, and KDI_Menu_Store_Flush before power off.
+ *
+ */
+
+#ifndef KDI_MENU_STORE_H_
+#define KDI_MENU_STORE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu.h
+ */
+#include "KDI_Menu.h"
+
+/*
+ * @brief	Time without changes before writing, in units of the function get time
+ */
+#ifndef KDI_MENU_STORE_IDLE_TIME
+#define KDI_MENU_STORE_IDLE_TIME	2000
+#endif
+
+/*
+ * @brief	Number of records written or read by one call of the functions of the flash
+ */
+#ifndef KDI_MENU_STORE_BATCH
+#define KDI_MENU_STORE_BATCH		16
+#endif
+
+/*
+ * @brief	First 4 bytes of a sector of the journal, "KDS2", sectors of other formats are not read
+ */
+#define KDI_MENU_STORE_MAGIC		0x3253444BUL
+
+/*
+ * @brief	Number of words of the table of changed values for the number of items
+ */
+#define KDI_MENU_STORE_DIRTY_SIZE(count)	(((count) + 31) / 32)
+
+/*
+ * @brief	Functions of the flash, addresses are counted from the start of the journal
+ */
+
+typedef struct{
+
+	uint32_t sector_size;												/*!< Size of a sector, multiple of 8 */
+
+	uint16_t sector_count;												/*!< Number of sectors, not less than 2 */
+
+	uint8_t(*read)(uint32_t address, void* data, uint32_t size);		/*!< Read data, return 1 if done */
+
+	uint8_t(*write)(uint32_t address, const void* data, uint32_t size);	/*!< Write data to erased flash, return 1 if done */
+
+	uint8_t(*erase)(uint32_t address);									/*!< Erase the sector with the address, all bytes 0xFF, return 1 if done */
+
+}KDI_Menu_Store_Flash;
+
+/*
+ * @brief	Record of the journal, the header of a sector has the same size.
+ * 			The check is the last field, so it is written last and a record stopped by reset is not valid
+ */
+
+typedef struct{
+
+	int32_t value;					/*!< Value of the item */
+
+	uint16_t id;					/*!< Number of the item, 0xFFFF - erased flash */
+
+	uint16_t check;					/*!< CRC-16 of number and value, never 0xFFFF */
+
+}KDI_Menu_Store_Record;
+
+/*
+ * @brief	State of the store
+ */
+
+typedef struct Menu_Store{
+
+	KDI_Menu* menu;							/*!< Menu with saved items */
+
+	const KDI_Menu_Store_Flash* flash;		/*!< Functions of the flash */
+
+	uint32_t* dirty;						/*!< Table of bits of changed values by number of item */
+
+	uint16_t dirty_count;					/*!< Number of changed values */
+
+	uint16_t sector;						/*!< Current sector */
+
+	uint32_t sequence;						/*!< Sequence number of current sector */
+
+	uint32_t position;						/*!< Offset of the next record in current sector */
+
+	uint32_t(*get_time)(void);				/*!< Pointer on function get time, 0 - write on each handler call */
+
+	uint32_t change_time;					/*!< Time of the last change */
+
+}KDI_Menu_Store;
+
+/*Initialization functions */
+KDI_Menu_Status KDI_Menu_Store_Init(KDI_Menu_Store* store, KDI_Menu* menu, const KDI_Menu_Store_Flash* flash,
+									uint32_t* dirty, uint32_t(*get_time)(void));
+KDI_Menu_Status KDI_Menu_Store_Restore(KDI_Menu_Store* store);
+
+/*Functions of changes */
+void KDI_Menu_Store_Changed(KDI_Menu_Store* store, uint16_t id);
+KDI_Menu_Status KDI_Menu_Store_Handler(KDI_Menu_Store* store);
+KDI_Menu_Status KDI_Menu_Store_Flush(KDI_Menu_Store* store);
+
+/*Flash in a file, for the computer */
+const KDI_Menu_Store_Flash* KDI_Menu_Store_File_Open(const char* path, uint32_t sector_size, uint16_t sector_count);
+void KDI_Menu_Store_File_Close(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_STORE_H_ */
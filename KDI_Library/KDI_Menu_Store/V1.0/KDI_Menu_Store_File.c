@@ -0,0 +1,162 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Store_File.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of flash in a file for KDI_Menu_Store module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for test KDI_Menu_Store on the computer. The journal is kept in a file,
+ * which works as NOR flash: erase sets all bytes of a sector to 0xFF, write only clears bits.
+ * One file can be opened at a time. Do not add this file to the project of the microcontroller.
+ *
+ */
+
+#include "KDI_Menu_Store.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Includes for FILE
+ */
+#include <stdio.h>
+
+/**
+ * @brief Opened file
+ */
+static FILE* KDI_Menu_Store_file = 0;
+
+/**
+ * @brief Functions of the opened file
+ */
+static KDI_Menu_Store_Flash KDI_Menu_Store_file_flash;
+
+/**
+ * @brief 		Read data from the file
+ *
+ * @param  		Address
+ * @param  		Pointer on data
+ * @param  		Size of data
+ * @return		1 if done
+ */
+
+static uint8_t KDI_Menu_Store_File_Read(uint32_t address, void* data, uint32_t size){
+
+	if(fseek(KDI_Menu_Store_file, (long)address, SEEK_SET)) return 0;
+
+	return fread(data, 1, size, KDI_Menu_Store_file) == size;
+}
+
+/**
+ * @brief 		Write data to the file, bits are only cleared
+ *
+ * @param  		Address
+ * @param  		Pointer on data
+ * @param  		Size of data
+ * @return		1 if done
+ */
+
+static uint8_t KDI_Menu_Store_File_Write(uint32_t address, const void* data, uint32_t size){
+
+	const uint8_t* bytes = (const uint8_t*)data;
+
+	for(uint32_t i = 0; i < size; i++){
+
+		uint8_t old;
+
+		if(!KDI_Menu_Store_File_Read(address + i, &old, 1)) return 0;
+
+		/* As NOR flash*/
+		old &= bytes[i];
+
+		if(fseek(KDI_Menu_Store_file, (long)(address + i), SEEK_SET) || fputc(old, KDI_Menu_Store_file) == EOF) return 0;
+	}
+
+	return fflush(KDI_Menu_Store_file) == 0;
+}
+
+/**
+ * @brief 		Erase sector of the file
+ *
+ * @param  		Address in the sector
+ * @return		1 if done
+ */
+
+static uint8_t KDI_Menu_Store_File_Erase(uint32_t address){
+
+	uint32_t size = KDI_Menu_Store_file_flash.sector_size;
+
+	address -= address % size;
+
+	if(fseek(KDI_Menu_Store_file, (long)address, SEEK_SET)) return 0;
+
+	for(uint32_t i = 0; i < size; i++){
+
+		if(fputc(0xFF, KDI_Menu_Store_file) == EOF) return 0;
+	}
+
+	return fflush(KDI_Menu_Store_file) == 0;
+}
+
+/**
+  * @brief 		Open file as flash
+  *
+  * @param  	Name of the file, it is created erased if it does not exist
+  * @param  	Size of a sector
+  * @param  	Number of sectors
+  *	@return		Pointer on functions of the flash for KDI_Menu_Store_Init, 0 if the file is not opened
+  */
+
+const KDI_Menu_Store_Flash* KDI_Menu_Store_File_Open(const char* path, uint32_t sector_size, uint16_t sector_count){
+
+	KDI_Menu_Store_File_Close();
+
+	KDI_Menu_Store_file = fopen(path, "r+b");
+
+	/* New file*/
+	if(!KDI_Menu_Store_file) KDI_Menu_Store_file = fopen(path, "w+b");
+
+	if(!KDI_Menu_Store_file) return 0;
+
+	KDI_Menu_Store_file_flash.sector_size = sector_size;
+	KDI_Menu_Store_file_flash.sector_count = sector_count;
+	KDI_Menu_Store_file_flash.read = KDI_Menu_Store_File_Read;
+	KDI_Menu_Store_file_flash.write = KDI_Menu_Store_File_Write;
+	KDI_Menu_Store_file_flash.erase = KDI_Menu_Store_File_Erase;
+
+	/* Erase sectors after the end of the file*/
+	fseek(KDI_Menu_Store_file, 0, SEEK_END);
+
+	long end = ftell(KDI_Menu_Store_file);
+
+	for(uint16_t sector = 0; sector < sector_count; sector++){
+
+		if((long)((sector + 1) * sector_size) <= end) continue;
+
+		if(!KDI_Menu_Store_File_Erase(sector * sector_size)){
+
+			KDI_Menu_Store_File_Close();
+			return 0;
+		}
+	}
+
+	return &KDI_Menu_Store_file_flash;
+}
+
+/**
+  * @brief 		Close file opened by KDI_Menu_Store_File_Open
+  * @param  	Nope
+  *	@return		Nope
+  */
+
+void KDI_Menu_Store_File_Close(void){
+
+	if(KDI_Menu_Store_file) fclose(KDI_Menu_Store_file);
+
+	KDI_Menu_Store_file = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
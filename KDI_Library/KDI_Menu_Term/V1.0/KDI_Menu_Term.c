@@ -0,0 +1,287 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Term.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Term module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for display KDI_Menu on a terminal with minimum of sent bytes.
+ *
+ * 	Escape sequences:
+ * 		ESC [ 2 J			-	clear the screen, sent by the first call and after KDI_Menu_Term_Redraw;
+ * 		ESC [ row ; col H	-	move the cursor, rows and columns from 1.
+ *
+ * Each line of the frame is compared with the screen. A changed part is sent after the escape sequence
+ * of its position, the sequence is skipped if the cursor is already there. Two changed parts with not more
+ * than KDI_MENU_TERM_GAP equal characters between them are sent as one part.
+ *
+ */
+
+#include "KDI_Menu_Term.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Terminal drawn by the current call of KDI_Menu_Term_Handler
+ */
+static KDI_Menu_Term* KDI_Menu_Term_current = 0;
+
+/**
+  * @brief 		Send the buffer to the terminal
+  * @param  	Pointer on KDI_Menu_Term
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Term_Flush(KDI_Menu_Term* term){
+
+	if(!term->length) return;
+
+	term->write(term->buffer, term->length);
+
+	term->sent += term->length;
+
+	term->length = 0;
+}
+
+/**
+  * @brief 		Add bytes to the buffer
+  *
+  * @param  	Pointer on KDI_Menu_Term
+  * @param  	Pointer on bytes
+  * @param  	Number of bytes
+  *	@return		Nope
+  *
+  * @note		If the buffer is full it is sent, so a frame bigger than the buffer is sent by several writes.
+  */
+
+static void KDI_Menu_Term_Put(KDI_Menu_Term* term, const char* data, uint16_t size){
+
+	while(size--){
+
+		if(term->length == KDI_MENU_TERM_BUFFER) KDI_Menu_Term_Flush(term);
+
+		term->buffer[term->length++] = *data++;
+	}
+}
+
+/**
+  * @brief 		Add escape sequence of cursor position
+  *
+  * @param  	Pointer on KDI_Menu_Term
+  * @param  	Line, from 0
+  * @param  	Column, from 0
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Term_Move(KDI_Menu_Term* term, uint8_t row, uint8_t column){
+
+	char number[KDI_FORMAT_BUFFER_SIZE];
+
+	KDI_Menu_Term_Put(term, "\033[", 2);
+
+	KDI_Menu_Term_Put(term, number, KDI_Format_Uint(number, row + 1U, 0));
+
+	KDI_Menu_Term_Put(term, ";", 1);
+
+	KDI_Menu_Term_Put(term, number, KDI_Format_Uint(number, column + 1U, 0));
+
+	KDI_Menu_Term_Put(term, "H", 1);
+}
+
+/**
+  * @brief 		Function set_line of the window, clears the line of the frame
+  * @param  	Number of the line
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Term_Set_Line(uint8_t line){
+
+	KDI_Menu_Term* term = KDI_Menu_Term_current;
+
+	term->row = line;
+
+	term->column = 0;
+
+	for(uint8_t i = 0; i < KDI_MENU_TERM_COLUMNS; i++) term->frame[line][i] = ' ';
+}
+
+/**
+  * @brief 		Print function of the menu, prints string in the frame
+  * @param  	String
+  *	@return		Nope
+  *
+  * @note		Characters after the end of the line are lost.
+  */
+
+static void KDI_Menu_Term_Print(char* string){
+
+	KDI_Menu_Term* term = KDI_Menu_Term_current;
+
+	while(*string && term->column < KDI_MENU_TERM_COLUMNS){
+
+		term->frame[term->row][term->column++] = *string++;
+	}
+}
+
+/**
+  * @brief 		Initialization terminal
+  *
+  * @param  	Pointer on KDI_Menu_Term
+  * @param  	Pointer on KDI_Menu
+  * @param  	Number of lines, not more than KDI_MENU_WINDOW_LINES
+  * @param		Pointer on function type "void name_fuction(const char* data, uint16_t size)", it sends bytes to the terminal
+  *	@return		Nope
+  *
+  * @note		The menu is not changed, print functions of the drawn menu are set by KDI_Menu_Term_Handler.
+  */
+
+void KDI_Menu_Term_Init(KDI_Menu_Term* term, KDI_Menu* menu, uint8_t lines, void(*write)(const char*, uint16_t)){
+
+	/* Lines are drawn by the window*/
+	KDI_Menu_Window_Init(&term->window, menu, lines, KDI_Menu_Term_Set_Line);
+
+	/* Save pointer on function*/
+	term->write = write;
+
+	term->length = 0;
+
+	term->sent = 0;
+
+	/* Clear frame*/
+	for(uint8_t line = 0; line < KDI_MENU_WINDOW_LINES; line++){
+
+		for(uint8_t i = 0; i < KDI_MENU_TERM_COLUMNS; i++) term->frame[line][i] = ' ';
+	}
+
+	/* Clear the screen on the next call*/
+	KDI_Menu_Term_Redraw(term);
+}
+
+/**
+  * @brief 		Clear the terminal and draw all lines on the next handler call
+  * @param  	Pointer on KDI_Menu_Term
+  *	@return		Nope
+  */
+
+void KDI_Menu_Term_Redraw(KDI_Menu_Term* term){
+
+	term->clear = 1;
+
+	KDI_Menu_Window_Redraw(&term->window);
+}
+
+/**
+  * @brief 		Forget items of the window, see KDI_Menu_Window_Reset
+  * @param  	Pointer on KDI_Menu_Term
+  *	@return		Nope
+  *
+  * @note		The screen is not cleared, only changed characters are sent on the next handler call.
+  */
+
+void KDI_Menu_Term_Reset(KDI_Menu_Term* term){
+
+	KDI_Menu_Window_Reset(&term->window);
+}
+
+/**
+  * @brief 		Displays window of items on the terminal
+  * @param  	Pointer on KDI_Menu_Term
+  *	@return		Nope
+  *
+  * @note		Nothing is sent if the frame is the same as the screen.
+  * 			Print functions of the menu are set to functions of the terminal.
+  */
+
+void KDI_Menu_Term_Handler(KDI_Menu_Term* term){
+
+	KDI_Menu_Term_Draw(term, term->window.menu);
+}
+
+/**
+  * @brief 		Displays window of items of other menu on the terminal
+  * @param  	Pointer on KDI_Menu_Term
+  * @param  	Pointer on KDI_Menu with the same items, for example the copy of KDI_Menu_Cursor_Enter
+  *	@return		Nope
+  *
+  * @note		Print functions of this menu are set to functions of the terminal, see KDI_Menu_Window_Draw.
+  */
+
+void KDI_Menu_Term_Draw(KDI_Menu_Term* term, KDI_Menu* menu){
+
+	/* Strings go to the frame, numbers are converted to strings*/
+	menu->print_string = KDI_Menu_Term_Print;
+
+	menu->print_int = 0;
+
+	menu->print_float = 0;
+
+	/* Draw changed lines of the frame*/
+	KDI_Menu_Term_current = term;
+
+	KDI_Menu_Window_Draw(&term->window, menu);
+
+	/* Empty screen*/
+	if(term->clear){
+
+		KDI_Menu_Term_Put(term, "\033[2J", 4);
+
+		for(uint8_t line = 0; line < KDI_MENU_WINDOW_LINES; line++){
+
+			for(uint8_t i = 0; i < KDI_MENU_TERM_COLUMNS; i++) term->screen[line][i] = ' ';
+		}
+
+		term->cursor_row = 0xFF;
+
+		term->clear = 0;
+	}
+
+	/* Send changed parts of lines*/
+	for(uint8_t row = 0; row < term->window.lines; row++){
+
+		char* frame = term->frame[row];
+
+		char* screen = term->screen[row];
+
+		uint8_t column = 0;
+
+		while(column < KDI_MENU_TERM_COLUMNS){
+
+			if(frame[column] == screen[column]){
+
+				column++;
+				continue;
+			}
+
+			/* End of the changed part, short equal parts are inside*/
+			uint8_t last = column;
+
+			for(uint8_t i = column + 1; i < KDI_MENU_TERM_COLUMNS && i - last <= KDI_MENU_TERM_GAP; i++){
+
+				if(frame[i] != screen[i]) last = i;
+			}
+
+			/* Move the cursor if it is not there*/
+			if(term->cursor_row != row || term->cursor_column != column) KDI_Menu_Term_Move(term, row, column);
+
+			KDI_Menu_Term_Put(term, &frame[column], (uint16_t)(last - column + 1));
+
+			for(uint8_t i = column; i <= last; i++) screen[i] = frame[i];
+
+			/* Position of the cursor after the last line is not known*/
+			column = last + 1;
+
+			term->cursor_row = (column < KDI_MENU_TERM_COLUMNS) ? row : 0xFF;
+
+			term->cursor_column = column;
+		}
+	}
+
+	/* One write of the frame*/
+	KDI_Menu_Term_Flush(term);
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,125 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Term.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Term module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for display KDI_Menu on a terminal (VT100 / ANSI) over a slow line, for example UART 9600.
+ * The menu is drawn by KDI_Menu_Window into a frame in RAM. The frame is compared with a copy of the screen of
+ * the terminal and only changed characters are sent, each changed part after an escape sequence which moves
+ * the cursor of the terminal. A move of the current item usually sends only the two markers.
+ * All bytes of one frame are collected in a buffer and given to the write function at once.
+ * The host test KDI_Menu_Test_Term decodes the sent bytes and checks the screen after each step.
+ *
+ * Numbers are printed as strings by KDI_Format. Only one terminal is drawn at a time,
+ * the handler sets the print functions of the menu to the functions of this module.
+ *
+ * 									##### How to use this driver #####
+ * 1) Create menu KDI_Menu.
+ * 2) Write function that sends bytes to the terminal:
+ *
+ * 		void uart_write(const char* data, uint16_t size);
+ *
+ * 3) Declare a structure KDI_Menu_Term and use function KDI_Menu_Term_Init.
+ * 4) Call KDI_Menu_Term_Handler instead of KDI_Menu_Handler.
+ * 5) If the terminal was cleared or connected again, use function KDI_Menu_Term_Redraw.
+ * 6) After KDI_Menu_Destroy or KDI_Menu_Pack of the menu use function KDI_Menu_Term_Reset.
+ * 7) For a cursor (KDI_Menu_Cursor) init own terminal of each user with the common menu, it is not changed,
+ *    and call KDI_Menu_Term_Draw with the copy of the menu made by KDI_Menu_Cursor_Enter.
+ *
+ * 									#### Example Used Library ####
+ *
+ * 		KDI_Menu_Term MyTerm;
+ *
+ * 		KDI_Menu_Term_Init(&MyTerm, &MyMenu, 4, uart_write);
+ *
+ * 		while(1){
+ *
+ * 			KDI_Menu_Queue_Pump... or KDI_Menu_Drive(&MyMenu, command);
+ * 			KDI_Menu_Term_Handler(&MyTerm);
+ * 		}
+ *
+ */
+
+#ifndef KDI_MENU_TERM_H_
+#define KDI_MENU_TERM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu_Window.h
+ * 			Lines of the frame are drawn by the window
+ *
+ */
+#include "KDI_Menu_Window.h"
+
+/*
+ * @brief	Number of characters in a line of the terminal
+ */
+#ifndef KDI_MENU_TERM_COLUMNS
+#define KDI_MENU_TERM_COLUMNS		20
+#endif
+
+/*
+ * @brief	Size of the buffer of one write, a whole frame with escape sequences by default
+ */
+#ifndef KDI_MENU_TERM_BUFFER
+#define KDI_MENU_TERM_BUFFER		(KDI_MENU_WINDOW_LINES * (KDI_MENU_TERM_COLUMNS + 8) + 8)
+#endif
+
+/*
+ * @brief	Not changed characters between two changed parts of a line which are sent instead of a new escape sequence
+ */
+#ifndef KDI_MENU_TERM_GAP
+#define KDI_MENU_TERM_GAP			5
+#endif
+
+/*
+ * @brief	Structure of the terminal
+ */
+
+typedef struct Menu_Term{
+
+	KDI_Menu_Window window;											/*!< Window which draws the frame */
+
+	void(*write)(const char*, uint16_t);							/*!< Pointer on function send bytes to the terminal */
+
+	uint8_t clear;													/*!< 1 - clear the screen on the next call */
+
+	uint8_t row;													/*!< Line of the frame for printing */
+
+	uint8_t column;													/*!< Column of the frame for printing */
+
+	uint8_t cursor_row;												/*!< Line of the cursor of the terminal, 0xFF - unknown */
+
+	uint8_t cursor_column;											/*!< Column of the cursor of the terminal */
+
+	uint16_t length;												/*!< Number of bytes in the buffer */
+
+	uint32_t sent;													/*!< Number of bytes sent since initialization */
+
+	char frame[KDI_MENU_WINDOW_LINES][KDI_MENU_TERM_COLUMNS];		/*!< New frame */
+
+	char screen[KDI_MENU_WINDOW_LINES][KDI_MENU_TERM_COLUMNS];		/*!< Characters on the terminal */
+
+	char buffer[KDI_MENU_TERM_BUFFER];								/*!< Bytes of one write */
+
+}KDI_Menu_Term;
+
+/*Initialization function */
+void KDI_Menu_Term_Init(KDI_Menu_Term* term, KDI_Menu* menu, uint8_t lines, void(*write)(const char*, uint16_t));
+
+/*Handler function */
+void KDI_Menu_Term_Handler(KDI_Menu_Term* term);
+void KDI_Menu_Term_Draw(KDI_Menu_Term* term, KDI_Menu* menu);
+void KDI_Menu_Term_Redraw(KDI_Menu_Term* term);
+void KDI_Menu_Term_Reset(KDI_Menu_Term* term);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_TERM_H_ */
@@ -0,0 +1,383 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Test_Image.c
+ * @author  		Polzuchy_haos
+ * @brief   		Host test of KDI_Menu_Image module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This program is built and started on the computer, not on the microcontroller.
+ * A large menu is built, written to a file by KDI_Menu_Image_Write, read back and started by KDI_Menu_Image_Load.
+ * Then both menus must give the same path (KDI_Menu_Get_Path) and the same printed item for each number
+ * of item and after each of many random commands. Only one array of items is used at a time, so results
+ * of the built menu are saved first and compared while the loaded menu is moved.
+ *
+ * At the end damaged copies of the image must not be loaded: a link on the parent changed in one item of a ring
+ * and a ring not closed.
+ *
+ * Links must be indices, the Makefile uses 16 bit links if LINK is 0.
+ * The program returns 0 if all results are the same.
+ *
+ */
+
+#include "KDI_Menu_Image.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 		File of the image, it is removed at the end
+ */
+#define KDI_TEST_FILE			"kdi_menu_test_image.bin"
+
+/**
+ * @brief 		Number of items on each level and number of levels, the menu must fit in links of 8 bits
+ */
+#if KDI_MENU_ITEM_LINK_BITS == 8
+#define KDI_TEST_WIDTH			6
+#define KDI_TEST_DEPTH			2
+#else
+#define KDI_TEST_WIDTH			10
+#define KDI_TEST_DEPTH			3
+#endif
+
+/**
+ * @brief 		Number of items of the menu, not less than the built items
+ */
+#define KDI_TEST_ITEMS			2200
+
+/**
+ * @brief 		Number of random commands
+ */
+#define KDI_TEST_COMMANDS		20000UL
+
+/**
+ * @brief 		Size of the path and printed item
+ */
+#define KDI_TEST_TEXT			64
+
+/**
+ * @brief 		Names and values of items, pointers on values and on the number item are bindings of the image
+ */
+static char KDI_Test_names[KDI_TEST_ITEMS][12];
+
+static int KDI_Test_values[KDI_TEST_ITEMS];
+
+static int KDI_Test_saved[KDI_TEST_ITEMS];
+
+static uint16_t KDI_Test_speed = 1500;
+
+static const KDI_Menu_Number KDI_Test_speed_item = {&KDI_Test_speed, TYPE_DATA_UINT16, 0, 0, 3000, 10};
+
+static void* KDI_Test_bindings[KDI_TEST_ITEMS + 1];
+
+static unsigned int KDI_Test_count;
+
+/**
+ * @brief 		Tables of items by number, paths and printed items of the built menu
+ */
+static KDI_Menu_item* KDI_Test_built_table[KDI_TEST_ITEMS];
+
+static KDI_Menu_item* KDI_Test_loaded_table[KDI_TEST_ITEMS];
+
+static char KDI_Test_paths[KDI_TEST_ITEMS][KDI_TEST_TEXT];
+
+static char KDI_Test_trace[KDI_TEST_COMMANDS][KDI_TEST_TEXT];
+
+/**
+ * @brief 		Text printed by the menu, path and text are in one result
+ */
+static char KDI_Test_text[KDI_TEST_TEXT / 2];
+
+static void KDI_Test_Print(char* string){
+
+	size_t length = strlen(KDI_Test_text);
+
+	snprintf(KDI_Test_text + length, sizeof(KDI_Test_text) - length, "%s", string);
+}
+
+/**
+ * @brief 		File of the image, write function of KDI_Menu_Image_Write
+ */
+static FILE* KDI_Test_file;
+
+static void KDI_Test_Write(const void* data, uint32_t size){
+
+	fwrite(data, 1, size, KDI_Test_file);
+}
+
+/**
+ * @brief 		Random numbers, the same on each start
+ */
+static unsigned long KDI_Test_seed;
+
+static unsigned int KDI_Test_Random(unsigned int range){
+
+	KDI_Test_seed = KDI_Test_seed * 1103515245UL + 12345UL;
+
+	return (unsigned int)((KDI_Test_seed >> 16) & 0x7FFF) % range;
+}
+
+/**
+  * @brief 		Build items below the current item
+  *
+  * @param  	Pointer on KDI_Menu, pointer is on the parent item
+  * @param		Number of levels below the current item
+  *	@return		Nope
+  */
+
+static void KDI_Test_Build(KDI_Menu* menu, unsigned int depth){
+
+	for(unsigned int i = 0; i < KDI_TEST_WIDTH; i++){
+
+		unsigned int number = KDI_Test_count++;
+
+		snprintf(KDI_Test_names[number], sizeof(KDI_Test_names[0]), "P%u", number);
+
+		KDI_Test_values[number] = (int)number * 7 - 1000;
+
+		KDI_Test_bindings[number] = &KDI_Test_values[number];
+
+		if(!i) KDI_Menu_Add_Child(menu, KDI_Test_names[number], TYPE_DATA_CHAR, MENU_NO_END, MENU_COMMAND_DOWN);
+		else KDI_Menu_Add_Next(menu, KDI_Test_names[number], TYPE_DATA_CHAR, MENU_COMMAND_FORWARD);
+
+		/* Data of the last level, variables and one number item*/
+		if(depth > 1) KDI_Test_Build(menu, depth - 1);
+		else if(number % 4) KDI_Menu_Add_Child(menu, &KDI_Test_values[number], TYPE_DATA_INT, MENU_END, MENU_COMMAND_NO);
+		else KDI_Menu_Add_Child(menu, (void*)&KDI_Test_speed_item, TYPE_DATA_NUMBER, MENU_END, MENU_COMMAND_NO);
+	}
+
+	KDI_Menu_Drive(menu, MENU_COMMAND_UP);
+}
+
+/**
+  * @brief 		Path and printed current item
+  * @param  	Pointer on KDI_Menu
+  * @param  	Buffer of KDI_TEST_TEXT characters
+  *	@return		Nope
+  */
+
+static void KDI_Test_Get(KDI_Menu* menu, char* text){
+
+	char path[KDI_TEST_TEXT / 2 - 1];
+
+	KDI_Menu_Get_Path(menu, path, sizeof(path));
+
+	KDI_Test_text[0] = 0;
+
+	KDI_Menu_Print_Item(menu, menu->pointer);
+
+	snprintf(text, KDI_TEST_TEXT, "%s=%s", path, KDI_Test_text);
+}
+
+/**
+  * @brief 		Random commands
+  * @param  	Pointer on KDI_Menu
+  * @param  	Number of the command
+  *	@return		Nope
+  */
+
+static void KDI_Test_Move(KDI_Menu* menu){
+
+	static const KDI_Menu_Command commands[4] = {MENU_COMMAND_FORWARD, MENU_COMMAND_BACKWARD, MENU_COMMAND_DOWN, MENU_COMMAND_UP};
+
+	unsigned int action = KDI_Test_Random(10);
+
+	if(action < 8) KDI_Menu_Drive(menu, commands[action % 4]);
+	else if(action < 9) KDI_Menu_Step(menu, (int)KDI_Test_Random(21) - 10);
+	else KDI_Menu_Jump(menu, (uint16_t)KDI_Test_Random(KDI_Test_count + 1));
+}
+
+/**
+  * @brief 		Load damaged copy of the image
+  *
+  * @param  	Image
+  * @param  	Size of the image
+  * @param  	Number of the changed item
+  * @param  	0 - change the link on parent, 1 - change the link on next item
+  *	@return		1 if the copy is not loaded
+  */
+
+static int KDI_Test_Damaged(const void* image, uint32_t size, uint32_t number, int link){
+
+	void* copy = malloc(size);
+
+	memcpy(copy, image, size);
+
+	const KDI_Menu_Image_Header* header = (const KDI_Menu_Image_Header*)copy;
+
+	KDI_Menu_item* items = (KDI_Menu_item*)((uint8_t*)copy + header->items);
+
+	KDI_Menu_item* item = &items[number];
+
+	if(link){
+
+		/* Next item of the next item, the ring is not closed*/
+		item->next_item = items[item->next_item - 1].next_item;
+
+	}else{
+
+#if !KDI_MENU_BREADCRUMB
+		/* Parent of other ring*/
+		item->parent_item = (KDI_Menu_link)(item->parent_item % header->item_count + 1);
+#endif
+	}
+
+	KDI_Menu menu;
+
+	int refused = KDI_Menu_Image_Load(&menu, copy, size, KDI_Test_bindings, (uint16_t)(KDI_Test_count + 1)) == MENU_STATUS_IMAGE_ERROR;
+
+	free(copy);
+
+	return refused;
+}
+
+int main(void){
+
+	static KDI_Menu built;
+
+	static KDI_Menu loaded;
+
+	/* Build*/
+	snprintf(KDI_Test_names[0], sizeof(KDI_Test_names[0]), "MENU");
+
+	KDI_Menu_Init(&built, KDI_Test_names[0], TYPE_DATA_CHAR);
+
+	KDI_Test_count = 1;
+
+	KDI_Test_Build(&built, KDI_TEST_DEPTH);
+
+	KDI_Test_bindings[KDI_Test_count] = (void*)&KDI_Test_speed_item;
+
+	uint16_t items = built.item_count;
+
+	KDI_Menu_Set_Id_Table(&built, KDI_Test_built_table, items);
+
+	KDI_Menu_Set_print_char(&built, KDI_Test_Print);
+	KDI_Menu_Set_print_int(&built, 0);
+	KDI_Menu_Set_print_float(&built, 0);
+
+	/* Results of the built menu*/
+	for(uint16_t id = 0; id < items; id++){
+
+		KDI_Menu_Jump(&built, id);
+
+		KDI_Test_Get(&built, KDI_Test_paths[id]);
+	}
+
+	/* Commands change values, the loaded menu starts with the same values*/
+	memcpy(KDI_Test_saved, KDI_Test_values, sizeof(KDI_Test_values));
+
+	uint16_t speed = KDI_Test_speed;
+
+	KDI_Menu_Jump(&built, 0);
+
+	KDI_Test_seed = 1;
+
+	for(unsigned long i = 0; i < KDI_TEST_COMMANDS; i++){
+
+		KDI_Test_Move(&built);
+
+		KDI_Test_Get(&built, KDI_Test_trace[i]);
+	}
+
+	/* Write the image*/
+	KDI_Test_file = fopen(KDI_TEST_FILE, "wb");
+
+	if(!KDI_Test_file || KDI_Menu_Image_Write(&built, KDI_Test_bindings, (uint16_t)(KDI_Test_count + 1), KDI_Test_Write) != MENU_STATUS_OK){
+
+		printf("image: FAIL, image is not written\n");
+		return 1;
+	}
+
+	fclose(KDI_Test_file);
+
+	/* Read the image*/
+	KDI_Test_file = fopen(KDI_TEST_FILE, "rb");
+
+	fseek(KDI_Test_file, 0, SEEK_END);
+
+	uint32_t size = (uint32_t)ftell(KDI_Test_file);
+
+	void* image = malloc(size);
+
+	fseek(KDI_Test_file, 0, SEEK_SET);
+
+	if(fread(image, 1, size, KDI_Test_file) != size) size = 0;
+
+	fclose(KDI_Test_file);
+
+	remove(KDI_TEST_FILE);
+
+	if(KDI_Menu_Image_Load(&loaded, image, size, KDI_Test_bindings, (uint16_t)(KDI_Test_count + 1)) != MENU_STATUS_OK){
+
+		printf("image: FAIL, image of %u bytes is not loaded\n", (unsigned int)size);
+		return 1;
+	}
+
+	KDI_Menu_Set_Id_Table(&loaded, KDI_Test_loaded_table, items);
+
+	KDI_Menu_Set_print_char(&loaded, KDI_Test_Print);
+	KDI_Menu_Set_print_int(&loaded, 0);
+	KDI_Menu_Set_print_float(&loaded, 0);
+
+	memcpy(KDI_Test_values, KDI_Test_saved, sizeof(KDI_Test_values));
+
+	KDI_Test_speed = speed;
+
+	/* Same results of the loaded menu*/
+	char text[KDI_TEST_TEXT];
+
+	for(uint16_t id = 0; id < items; id++){
+
+		KDI_Menu_Jump(&loaded, id);
+
+		KDI_Test_Get(&loaded, text);
+
+		if(strcmp(text, KDI_Test_paths[id])){
+
+			printf("image: FAIL, item %u is \"%s\" instead of \"%s\"\n", id, text, KDI_Test_paths[id]);
+			return 1;
+		}
+	}
+
+	KDI_Menu_Jump(&loaded, 0);
+
+	KDI_Test_seed = 1;
+
+	for(unsigned long i = 0; i < KDI_TEST_COMMANDS; i++){
+
+		KDI_Test_Move(&loaded);
+
+		KDI_Test_Get(&loaded, text);
+
+		if(strcmp(text, KDI_Test_trace[i])){
+
+			printf("image: FAIL, command %lu gives \"%s\" instead of \"%s\"\n", i, text, KDI_Test_trace[i]);
+			return 1;
+		}
+	}
+
+	/* Damaged images, item 2 is the second item of the ring below item 1*/
+	if(!KDI_Test_Damaged(image, size, 2, 1)){
+
+		printf("image: FAIL, ring which is not closed is loaded\n");
+		return 1;
+	}
+
+#if !KDI_MENU_BREADCRUMB
+	for(uint32_t number = 2; number < items; number++){
+
+		if(KDI_Test_Damaged(image, size, number, 0)) continue;
+
+		printf("image: FAIL, wrong parent of item %u is loaded\n", (unsigned int)number);
+		return 1;
+	}
+#endif
+
+	free(image);
+
+	printf("image: OK, %u items, %u bytes, %lu commands\n", (unsigned int)items, (unsigned int)size, KDI_TEST_COMMANDS);
+
+	return 0;
+}
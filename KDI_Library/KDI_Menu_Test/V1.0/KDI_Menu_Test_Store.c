@@ -0,0 +1,240 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Test_Store.c
+ * @author  		Polzuchy_haos
+ * @brief   		Host test of KDI_Menu_Store module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This program is built and started on the computer, not on the microcontroller.
+ * The journal is kept in a file by KDI_Menu_Store_File_Open, its functions are called through
+ * functions of this test, which make one write or erase fail. A failed write clears only the first half
+ * of its bytes, as flash stopped while writing, a failed erase does not change the sector.
+ *
+ * For each number of the failed operation the values of two items are changed and flushed many times,
+ * so the journal goes around all sectors. After each flush which returns MENU_STATUS_OK the journal is
+ * restored as after reset and must give the flushed values. After a failed flush the values are
+ * flushed again, this must succeed and also be restored.
+ *
+ * The program prints the number of checked restores and returns 0 if all of them are right.
+ *
+ */
+
+#include "KDI_Menu_Store.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 		File of the journal, it is removed at the end
+ */
+#define KDI_TEST_FILE			"kdi_menu_test_store.bin"
+
+/**
+ * @brief 		Size of sector: header and 7 records
+ */
+#define KDI_TEST_SECTOR_SIZE	64
+
+/**
+ * @brief 		Number of changes of values for each failed operation
+ */
+#define KDI_TEST_CHANGES		40
+
+/**
+ * @brief 		Flash in the file
+ */
+static const KDI_Menu_Store_Flash* KDI_Test_file;
+
+/**
+ * @brief 		Number of writes and erases before the failed one, -1 - no fail
+ */
+static long KDI_Test_fail = -1;
+
+/**
+ * @brief 		Check if the operation fails
+ */
+static uint8_t KDI_Test_Fail(void){
+
+	if(KDI_Test_fail < 0) return 0;
+
+	return KDI_Test_fail-- == 0;
+}
+
+/**
+ * @brief 		Functions of the flash with fail
+ */
+static uint8_t KDI_Test_Read(uint32_t address, void* data, uint32_t size){
+
+	return KDI_Test_file->read(address, data, size);
+}
+
+static uint8_t KDI_Test_Write(uint32_t address, const void* data, uint32_t size){
+
+	if(!KDI_Test_Fail()) return KDI_Test_file->write(address, data, size);
+
+	/* Stopped in the middle*/
+	KDI_Test_file->write(address, data, size / 2);
+
+	return 0;
+}
+
+static uint8_t KDI_Test_Erase(uint32_t address){
+
+	if(KDI_Test_Fail()) return 0;
+
+	return KDI_Test_file->erase(address);
+}
+
+/**
+ * @brief 		Values and items
+ */
+static int16_t KDI_Test_speed;
+static int16_t KDI_Test_power;
+
+static const KDI_Menu_Number KDI_Test_speed_item = {&KDI_Test_speed, TYPE_DATA_INT16, 0, -1000, 1000, 1};
+static const KDI_Menu_Number KDI_Test_power_item = {&KDI_Test_power, TYPE_DATA_INT16, 0, -1000, 1000, 1};
+
+static KDI_Menu KDI_Test_menu;
+
+static KDI_Menu_item* KDI_Test_table[8];
+
+static uint32_t KDI_Test_dirty[KDI_MENU_STORE_DIRTY_SIZE(8)];
+
+/**
+ * @brief 		Check that the journal restores the values
+ * @param  		Store
+ * @return		1 if right
+ */
+static int KDI_Test_Restored(const KDI_Menu_Store* store){
+
+	int16_t speed = KDI_Test_speed;
+	int16_t power = KDI_Test_power;
+
+	/* Other store, as after reset*/
+	KDI_Menu_Store reset = *store;
+
+	KDI_Test_speed = 0;
+	KDI_Test_power = 0;
+
+	long fail = KDI_Test_fail;
+
+	KDI_Test_fail = -1;
+
+	KDI_Menu_Status status = KDI_Menu_Store_Restore(&reset);
+
+	KDI_Test_fail = fail;
+
+	int right = status == MENU_STATUS_OK && KDI_Test_speed == speed && KDI_Test_power == power;
+
+	if(!right) printf("restored %d %d instead of %d %d, status %d\n", KDI_Test_speed, KDI_Test_power, speed, power, status);
+
+	KDI_Test_speed = speed;
+	KDI_Test_power = power;
+
+	return right;
+}
+
+/**
+ * @brief 		Changes of values with one failed operation
+ * @param  		Number of sectors
+ * @param  		Number of the failed operation
+ * @param  		Number of checked restores
+ * @return		1 if right
+ */
+static int KDI_Test_Run(uint16_t sectors, long fail, unsigned long* checked){
+
+	static const KDI_Menu_Store_Flash flash_fail = {0, 0, KDI_Test_Read, KDI_Test_Write, KDI_Test_Erase};
+
+	KDI_Menu_Store_Flash flash = flash_fail;
+
+	KDI_Menu_Store store;
+
+	/* Erased journal*/
+	remove(KDI_TEST_FILE);
+
+	KDI_Test_file = KDI_Menu_Store_File_Open(KDI_TEST_FILE, KDI_TEST_SECTOR_SIZE, sectors);
+
+	if(!KDI_Test_file){
+
+		printf("file %s is not opened\n", KDI_TEST_FILE);
+		return 0;
+	}
+
+	flash.sector_size = KDI_TEST_SECTOR_SIZE;
+	flash.sector_count = sectors;
+
+	KDI_Test_fail = -1;
+
+	KDI_Test_speed = 42;
+	KDI_Test_power = -42;
+
+	if(KDI_Menu_Store_Init(&store, &KDI_Test_menu, &flash, KDI_Test_dirty, 0) != MENU_STATUS_OK
+			|| KDI_Menu_Store_Restore(&store) != MENU_STATUS_NOT_FOUND || !KDI_Test_Restored(&store)) return 0;
+
+	KDI_Test_fail = fail;
+
+	for(int change = 1; change <= KDI_TEST_CHANGES; change++){
+
+		KDI_Test_speed = (int16_t)(42 + change);
+		KDI_Test_power = (int16_t)(-42 - change);
+
+		KDI_Menu_Store_Changed(&store, 1);
+		KDI_Menu_Store_Changed(&store, 3);
+
+		/* Failed flush, values stay marked and are written again*/
+		if(KDI_Menu_Store_Flush(&store) != MENU_STATUS_OK){
+
+			if(store.dirty_count != 2){
+
+				printf("failed flush cleared values\n");
+				return 0;
+			}
+
+			if(KDI_Menu_Store_Flush(&store) != MENU_STATUS_OK){
+
+				printf("flush after error failed\n");
+				return 0;
+			}
+		}
+
+		if(!KDI_Test_Restored(&store)) return 0;
+
+		(*checked)++;
+	}
+
+	return 1;
+}
+
+int main(void){
+
+	unsigned long checked = 0;
+
+	/* Menu: two data items with numbers 1 and 3*/
+	KDI_Menu_Init(&KDI_Test_menu, "SPEED", TYPE_DATA_CHAR);
+	KDI_Menu_Add_Child(&KDI_Test_menu, (void*)&KDI_Test_speed_item, TYPE_DATA_NUMBER, MENU_END, MENU_COMMAND_NO);
+	KDI_Menu_Add_Next(&KDI_Test_menu, "POWER", TYPE_DATA_CHAR, MENU_COMMAND_FORWARD);
+	KDI_Menu_Add_Child(&KDI_Test_menu, (void*)&KDI_Test_power_item, TYPE_DATA_NUMBER, MENU_END, MENU_COMMAND_NO);
+
+	KDI_Menu_Set_Id_Table(&KDI_Test_menu, KDI_Test_table, 8);
+
+	/* Two sectors, where starting the same sector again erases the only valid one, and three sectors*/
+	for(uint16_t sectors = 2; sectors <= 3; sectors++){
+
+		for(long fail = -1; fail < KDI_TEST_CHANGES * 4; fail++){
+
+			if(KDI_Test_Run(sectors, fail, &checked)) continue;
+
+			printf("store: FAIL, %u sectors, operation %ld failed\n", sectors, fail);
+
+			KDI_Menu_Store_File_Close();
+			remove(KDI_TEST_FILE);
+			return 1;
+		}
+	}
+
+	KDI_Menu_Store_File_Close();
+	remove(KDI_TEST_FILE);
+
+	printf("store: OK, %lu restores checked\n", checked);
+
+	return 0;
+}
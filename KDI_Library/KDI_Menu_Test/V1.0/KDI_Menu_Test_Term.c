@@ -0,0 +1,259 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Test_Term.c
+ * @author  		Polzuchy_haos
+ * @brief   		Host test of KDI_Menu_Term module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This program is built and started on the computer, not on the microcontroller.
+ * Bytes sent by KDI_Menu_Term are given to a small terminal of this test, which knows the sequences
+ * of KDI_Menu_Term (clear the screen, move the cursor) and writes other characters on its screen.
+ * Any other byte, or a character after the end of a line, is an error.
+ *
+ * The menu is moved by random commands, values of items are changed, sometimes the terminal is
+ * drawn again or reset. After each step the screen of the test must be the same as the frame of KDI_Menu_Term.
+ *
+ * The program prints the number of steps and bytes sent for one step and returns 0 if all screens are right.
+ *
+ */
+
+#include "KDI_Menu_Term.h"
+
+#include <stdio.h>
+
+/**
+ * @brief 		Number of random steps
+ */
+#define KDI_TEST_STEPS			20000UL
+
+/**
+ * @brief 		Number of items on each level and number of levels
+ */
+#define KDI_TEST_WIDTH			7
+#define KDI_TEST_DEPTH			3
+
+/**
+ * @brief 		Names of items of different length and values of data items
+ */
+#define KDI_TEST_ITEMS			512
+
+static char KDI_Test_names[KDI_TEST_ITEMS][16];
+
+static int KDI_Test_values[KDI_TEST_ITEMS];
+
+static unsigned int KDI_Test_count;
+
+/**
+ * @brief 		Screen of the terminal of the test
+ */
+static char KDI_Test_screen[KDI_MENU_WINDOW_LINES][KDI_MENU_TERM_COLUMNS];
+
+/**
+ * @brief 		Cursor of the terminal, started escape sequence and its numbers
+ */
+static unsigned int KDI_Test_row;
+static unsigned int KDI_Test_column;
+
+static unsigned int KDI_Test_escape;
+static unsigned int KDI_Test_number[2];
+
+/**
+ * @brief 		Number of received bytes and errors
+ */
+static unsigned long KDI_Test_bytes;
+static unsigned long KDI_Test_errors;
+
+/**
+ * @brief 		Random numbers, the same on each start
+ */
+static unsigned long KDI_Test_seed = 12345;
+
+static unsigned int KDI_Test_Random(unsigned int range){
+
+	KDI_Test_seed = KDI_Test_seed * 1103515245UL + 12345UL;
+
+	return (unsigned int)((KDI_Test_seed >> 16) & 0x7FFF) % range;
+}
+
+/**
+  * @brief 		Terminal of the test, write function of KDI_Menu_Term
+  *
+  * @param  	Bytes
+  * @param  	Number of bytes
+  *	@return		Nope
+  *
+  * @note		Escape sequences: ESC [ 2 J and ESC [ row ; column H.
+  */
+
+static void KDI_Test_Write(const char* data, uint16_t size){
+
+	KDI_Test_bytes += size;
+
+	for(uint16_t i = 0; i < size; i++){
+
+		char byte = data[i];
+
+		/* Start of sequence*/
+		if(KDI_Test_escape == 1){
+
+			KDI_Test_escape = (byte == '[') ? 2 : 0;
+
+			if(!KDI_Test_escape) KDI_Test_errors++;
+
+			continue;
+		}
+
+		/* Numbers and end of sequence*/
+		if(KDI_Test_escape){
+
+			unsigned int* number = &KDI_Test_number[KDI_Test_escape - 2];
+
+			if(byte >= '0' && byte <= '9'){
+
+				*number = *number * 10 + (unsigned int)(byte - '0');
+
+			}else if(byte == ';' && KDI_Test_escape == 2){
+
+				KDI_Test_escape = 3;
+
+			}else if(byte == 'J' && KDI_Test_escape == 2 && KDI_Test_number[0] == 2){
+
+				for(unsigned int row = 0; row < KDI_MENU_WINDOW_LINES; row++){
+
+					for(unsigned int column = 0; column < KDI_MENU_TERM_COLUMNS; column++) KDI_Test_screen[row][column] = ' ';
+				}
+
+				KDI_Test_escape = 0;
+
+			}else if(byte == 'H' && KDI_Test_escape == 3 && KDI_Test_number[0] && KDI_Test_number[1]){
+
+				KDI_Test_row = KDI_Test_number[0] - 1;
+
+				KDI_Test_column = KDI_Test_number[1] - 1;
+
+				KDI_Test_escape = 0;
+
+			}else{
+
+				KDI_Test_errors++;
+
+				KDI_Test_escape = 0;
+			}
+
+			continue;
+		}
+
+		if(byte == '\033'){
+
+			KDI_Test_escape = 1;
+
+			KDI_Test_number[0] = 0;
+			KDI_Test_number[1] = 0;
+
+			continue;
+		}
+
+		/* Character on the screen*/
+		if(byte < ' ' || KDI_Test_row >= KDI_MENU_WINDOW_LINES || KDI_Test_column >= KDI_MENU_TERM_COLUMNS){
+
+			KDI_Test_errors++;
+			continue;
+		}
+
+		KDI_Test_screen[KDI_Test_row][KDI_Test_column++] = byte;
+	}
+}
+
+/**
+  * @brief 		Build items below the current item
+  *
+  * @param  	Pointer on KDI_Menu, pointer is on the parent item
+  * @param		Number of levels below the current item
+  *	@return		Nope
+  */
+
+static void KDI_Test_Build(KDI_Menu* menu, unsigned int depth){
+
+	for(unsigned int i = 0; i < KDI_TEST_WIDTH && KDI_Test_count < KDI_TEST_ITEMS; i++){
+
+		unsigned int number = KDI_Test_count++;
+
+		/* Names of different length, also longer than the line*/
+		snprintf(KDI_Test_names[number], sizeof(KDI_Test_names[0]), "P%u%.*s", number, (int)(number % 9), "ABCDEFGHI");
+
+		KDI_Test_values[number] = (int)number * 7;
+
+		if(!i) KDI_Menu_Add_Child(menu, KDI_Test_names[number], TYPE_DATA_CHAR, MENU_NO_END, MENU_COMMAND_DOWN);
+		else KDI_Menu_Add_Next(menu, KDI_Test_names[number], TYPE_DATA_CHAR, MENU_COMMAND_FORWARD);
+
+		/* Data of the last level*/
+		if(depth > 1) KDI_Test_Build(menu, depth - 1);
+		else KDI_Menu_Add_Child(menu, &KDI_Test_values[number], TYPE_DATA_INT, MENU_END, MENU_COMMAND_NO);
+	}
+
+	KDI_Menu_Drive(menu, MENU_COMMAND_UP);
+}
+
+int main(void){
+
+	static KDI_Menu menu;
+
+	static KDI_Menu_Term term;
+
+	KDI_Menu_Init(&menu, "MENU", TYPE_DATA_CHAR);
+
+	KDI_Test_Build(&menu, KDI_TEST_DEPTH);
+
+	KDI_Menu_Jump_Item(&menu, menu.Head);
+
+	KDI_Menu_Term_Init(&term, &menu, KDI_MENU_WINDOW_LINES, KDI_Test_Write);
+
+	/* Screen before the first clear is unknown*/
+	for(unsigned int row = 0; row < KDI_MENU_WINDOW_LINES; row++){
+
+		for(unsigned int column = 0; column < KDI_MENU_TERM_COLUMNS; column++) KDI_Test_screen[row][column] = '?';
+	}
+
+	KDI_Menu_Term_Handler(&term);
+
+	unsigned long first = KDI_Test_bytes;
+
+	for(unsigned long step = 0; step < KDI_TEST_STEPS; step++){
+
+		unsigned int action = KDI_Test_Random(100);
+
+		if(action < 40) KDI_Menu_Drive(&menu, MENU_COMMAND_FORWARD);
+		else if(action < 60) KDI_Menu_Drive(&menu, MENU_COMMAND_BACKWARD);
+		else if(action < 75) KDI_Menu_Drive(&menu, MENU_COMMAND_DOWN);
+		else if(action < 90) KDI_Menu_Drive(&menu, MENU_COMMAND_UP);
+		else if(action < 98) KDI_Test_values[KDI_Test_Random(KDI_Test_count)] += (int)KDI_Test_Random(2001) - 1000;
+		else if(action < 99) KDI_Menu_Term_Redraw(&term);
+		else KDI_Menu_Term_Reset(&term);
+
+		KDI_Menu_Term_Handler(&term);
+
+		/* Screen of the test is the frame*/
+		for(unsigned int row = 0; row < term.window.lines; row++){
+
+			for(unsigned int column = 0; column < KDI_MENU_TERM_COLUMNS; column++){
+
+				if(KDI_Test_screen[row][column] == term.frame[row][column]) continue;
+
+				printf("term: FAIL, step %lu line %u: \"%.*s\" instead of \"%.*s\"\n", step, row,
+						KDI_MENU_TERM_COLUMNS, KDI_Test_screen[row], KDI_MENU_TERM_COLUMNS, term.frame[row]);
+				return 1;
+			}
+		}
+
+		if(KDI_Test_errors){
+
+			printf("term: FAIL, step %lu, wrong bytes\n", step);
+			return 1;
+		}
+	}
+
+	printf("term: OK, %lu steps, first frame %lu bytes, %.2f bytes per step\n", KDI_TEST_STEPS, first,
+			(double)(KDI_Test_bytes - first) / KDI_TEST_STEPS);
+
+	return 0;
+}
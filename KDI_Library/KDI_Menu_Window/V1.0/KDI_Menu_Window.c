@@ -0,0 +1,235 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Window.c
+ * @author  		Polzuchy_haos
+ * @brief   		Source file of KDI_Menu_Window module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for display several items of KDI_Menu at once, for character LCD (for example 4 lines)
+ * and terminals. The window shows the current item and its neighbours from the same level,
+ * the current item is marked. The first item of the window is saved, so a move inside the window
+ * prints only two lines: the old and the new current item. Lines are printed only if they changed.
+ *
+ * 	How the window moves:
+ * 		-	current item is inside the window			-	the window is not moved;
+ * 		-	current item is right after the last line	-	the window is moved down by one line;
+ * 		-	current item is right before the first line	-	the window is moved up by one line;
+ * 		-	other cases (other level, jump)				-	current item is printed on the first line.
+ *
+ */
+
+#include "KDI_Menu_Window.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+  * @brief 		Initialization window
+  *
+  * @param  	Pointer on KDI_Menu_Window
+  * @param  	Pointer on KDI_Menu
+  * @param  	Number of lines, not more than KDI_MENU_WINDOW_LINES
+  * @param		Pointer on function type "void name_fuction(uint8_t line)",
+  * 			it moves output to the start of the line and clears the line
+  *	@return		Nope
+  */
+
+void KDI_Menu_Window_Init(KDI_Menu_Window* window, KDI_Menu* menu, uint8_t lines, void(*set_line)(uint8_t)){
+
+	/* Save menu*/
+	window->menu = menu;
+
+	/* Check number of lines*/
+	if(lines > KDI_MENU_WINDOW_LINES) lines = KDI_MENU_WINDOW_LINES;
+
+	window->lines = lines;
+
+	/* Save pointer on function*/
+	window->set_line = set_line;
+
+	/* Default marker*/
+	KDI_Menu_Window_Set_Marker(window, ">", " ");
+
+	/* Window is not placed yet*/
+	KDI_Menu_Window_Reset(window);
+}
+
+/**
+  * @brief 		Save marker of current item
+  *
+  * @param  	Pointer on KDI_Menu_Window
+  * @param  	String printed before current item
+  * @param  	String printed before other items, usually spaces of the same length
+  *	@return		Nope
+  */
+
+void KDI_Menu_Window_Set_Marker(KDI_Menu_Window* window, char* marker, char* space){
+
+	/* Save strings*/
+	window->marker = marker;
+
+	window->space = space;
+
+	/* Print all lines on the next call*/
+	KDI_Menu_Window_Redraw(window);
+}
+
+/**
+  * @brief 		Print all lines on the next handler call
+  * @param  	Pointer on KDI_Menu_Window
+  *	@return		Nope
+  */
+
+void KDI_Menu_Window_Redraw(KDI_Menu_Window* window){
+
+	/* Set flag*/
+	window->redraw = 1;
+}
+
+/**
+  * @brief 		Forget items of the window and print all lines on the next handler call
+  * @param  	Pointer on KDI_Menu_Window
+  *	@return		Nope
+  *
+  * @note		Call it after KDI_Menu_Destroy or KDI_Menu_Pack of the menu, the window keeps pointers
+  * 			on items and they are freed by these functions. The window is placed again from the current item.
+  */
+
+void KDI_Menu_Window_Reset(KDI_Menu_Window* window){
+
+	/* Window is not placed*/
+	window->first = 0;
+
+	/* Lines are empty*/
+	for(uint8_t number = 0; number < KDI_MENU_WINDOW_LINES; number++){
+
+		window->line[number].item = 0;
+
+		window->line[number].marked = 0;
+	}
+
+	/* Print all lines on the next call*/
+	KDI_Menu_Window_Redraw(window);
+}
+
+/**
+  * @brief 		Move window so that current item is inside it
+  * @param  	Pointer on KDI_Menu_Window
+  * @param  	Current item
+  *	@return		Nope
+  */
+
+static void KDI_Menu_Window_Place(KDI_Menu_Window* window, KDI_Menu_item* pointer){
+
+	/* Item of the line*/
+	KDI_Menu_item* item = window->first;
+
+	/* Window is not placed*/
+	if(!item){
+
+		window->first = pointer;
+		return;
+	}
+
+	/* Find current item inside window*/
+	for(uint8_t line = 0; line < window->lines; line++){
+
+		if(item == pointer) return;
+
+		item = KDI_MENU_ITEM_NEXT(item);
+
+		/* Ring is shorter than window, current item is on other level*/
+		if(item == window->first){
+
+			window->first = pointer;
+			return;
+		}
+	}
+
+	/* Current item is right after the last line, move down by one line*/
+	if(item == pointer){
+
+		window->first = KDI_MENU_ITEM_NEXT(window->first);
+
+	/* Current item is right before the first line, move up by one line, or other cases*/
+	}else{
+
+		window->first = pointer;
+	}
+}
+
+/**
+  * @brief 		Displays window of items
+  * @param  	Pointer on KDI_Menu_Window
+  *	@return		Nope
+  *
+  * @note		Only changed lines are printed.
+  */
+
+void KDI_Menu_Window_Handler(KDI_Menu_Window* window){
+
+	KDI_Menu_Window_Draw(window, window->menu);
+}
+
+/**
+  * @brief 		Displays window of items of other menu
+  * @param  	Pointer on KDI_Menu_Window
+  * @param  	Pointer on KDI_Menu with the same items, for example the copy of KDI_Menu_Cursor_Enter
+  *	@return		Nope
+  *
+  * @note		Current item and print functions are taken from this menu, the menu of the window is not used.
+  */
+
+void KDI_Menu_Window_Draw(KDI_Menu_Window* window, KDI_Menu* menu){
+
+	/* Move window*/
+	KDI_Menu_Window_Place(window, menu->pointer);
+
+	/* Item of the line*/
+	KDI_Menu_item* item = window->first;
+
+	for(uint8_t number = 0; number < window->lines; number++){
+
+		KDI_Menu_Window_line* line = &window->line[number];
+
+		/* Item is marked if it is current*/
+		uint8_t marked = (item == menu->pointer);
+
+		/* Save value of item and check changes*/
+		uint8_t changed = item ? KDI_Menu_Update_Item(menu, item, &line->value) : 0;
+
+		/* Print only changed line*/
+		if(window->redraw || changed || item != line->item || marked != line->marked){
+
+			window->set_line(number);
+
+			if(item){
+
+				menu->print_string(marked ? window->marker : window->space);
+
+				KDI_Menu_Print_Item(menu, item);
+			}
+
+			/* Save printed line*/
+			line->item = item;
+
+			line->marked = marked;
+		}
+
+		/* Next item, lines after the end of the ring are empty*/
+		if(item){
+
+			item = KDI_MENU_ITEM_NEXT(item);
+
+			if(item == window->first) item = 0;
+		}
+	}
+
+	/* All lines are printed*/
+	window->redraw = 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,113 @@
+/*****************************************************************************
+ * @file    		KDI_Menu_Window.h
+ * @author  		Polzuchy_haos
+ * @brief   		Header file of KDI_Menu_Window module.
+ * @version			1.0
+ *
+ * ***************************************************************************
+ * This software used for display several items of KDI_Menu at once, for character LCD (for example 4 lines)
+ * and terminals. The window shows the current item and its neighbours from the same level,
+ * the current item is marked. The first item of the window is saved, so a move inside the window
+ * prints only two lines: the old and the new current item. Lines are printed only if they changed.
+ *
+ * 									##### How to use this driver #####
+ * 1) Create menu KDI_Menu and set its print functions.
+ * 2) Write function that moves output to the start of the line and clears the line:
+ *
+ * 		void lcd_set_line(uint8_t line);
+ *
+ * 3) Declare a structure KDI_Menu_Window and use function KDI_Menu_Window_Init.
+ * 4) If needed, change marker of current item use function KDI_Menu_Window_Set_Marker, by default ">" and " ".
+ * 5) Call KDI_Menu_Window_Handler instead of KDI_Menu_Handler.
+ * 6) After KDI_Menu_Destroy or KDI_Menu_Pack of the menu call KDI_Menu_Window_Reset, the window keeps pointers on items.
+ * 7) For a cursor (KDI_Menu_Cursor) use own window of each user and call KDI_Menu_Window_Draw with the copy
+ *    of the menu made by KDI_Menu_Cursor_Enter instead of KDI_Menu_Window_Handler.
+ *
+ * 									#### Example Used Library ####
+ *
+ * 		KDI_Menu_Window MyWindow;
+ *
+ * 		KDI_Menu_Window_Init(&MyWindow, &MyMenu, 4, lcd_set_line);
+ *
+ * 		if(button == pressed){
+ *
+ * 			KDI_Menu_Drive(&MyMenu, MENU_COMMAND_FORWARD);
+ * 			KDI_Menu_Window_Handler(&MyWindow);
+ * 		}
+ *
+ */
+
+#ifndef KDI_MENU_WINDOW_H_
+#define KDI_MENU_WINDOW_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * @brief	Includes lib KDI_Menu.h
+ * 			Items are printed by print functions of KDI_Menu
+ *
+ */
+#include "KDI_Menu.h"
+
+/*
+ * @brief	Maximum number of lines of the window
+ */
+#ifndef KDI_MENU_WINDOW_LINES
+#define KDI_MENU_WINDOW_LINES		4
+#endif
+
+/*
+ * @brief	One line of the window
+ */
+
+typedef struct{
+
+	KDI_Menu_item* item;			/*!< Item printed on the line, 0 - empty line */
+
+	uint8_t marked;					/*!< 1 if the line is printed with marker */
+
+	KDI_Menu_Value value;			/*!< Copy of the printed value */
+
+}KDI_Menu_Window_line;
+
+/*
+ * @brief	Structure of the window
+ */
+
+typedef struct Menu_Window{
+
+	KDI_Menu* menu;										/*!< Pointer on displayed menu */
+
+	KDI_Menu_item* first;								/*!< Item on the first line */
+
+	uint8_t lines;										/*!< Number of lines */
+
+	uint8_t redraw;										/*!< 1 - print all lines on the next call */
+
+	char* marker;										/*!< String before current item */
+
+	char* space;										/*!< String before other items */
+
+	void(*set_line)(uint8_t );							/*!< Pointer on function move output to the start of the line and clear it */
+
+	KDI_Menu_Window_line line[KDI_MENU_WINDOW_LINES];	/*!< Printed lines */
+
+}KDI_Menu_Window;
+
+/*Initialization function */
+void KDI_Menu_Window_Init(KDI_Menu_Window* window, KDI_Menu* menu, uint8_t lines, void(*set_line)(uint8_t));
+void KDI_Menu_Window_Set_Marker(KDI_Menu_Window* window, char* marker, char* space);
+
+/*Handler function */
+void KDI_Menu_Window_Handler(KDI_Menu_Window* window);
+void KDI_Menu_Window_Draw(KDI_Menu_Window* window, KDI_Menu* menu);
+void KDI_Menu_Window_Redraw(KDI_Menu_Window* window);
+void KDI_Menu_Window_Reset(KDI_Menu_Window* window);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* KDI_MENU_WINDOW_H_ */